@@ -5,8 +5,143 @@
 #include <atomic>
 #include <type_traits>
 
+#if __has_include(<thread>)
+#include <thread>
+#endif
+
 namespace stdx {
 inline namespace v1 {
+namespace detail {
+inline auto cpu_relax() -> void {
+#if defined(__x86_64__) or defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) or defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+constexpr auto failure_order(std::memory_order mo) -> std::memory_order {
+    switch (mo) {
+    case std::memory_order_acq_rel: return std::memory_order_acquire;
+    case std::memory_order_release: return std::memory_order_relaxed;
+    default: return mo;
+    }
+}
+} // namespace detail
+
+// The ::atomic layer customizes the storage type and plain atomic accesses,
+// but it has no compare-exchange or waiting. Those come from an injectable
+// policy, so that a platform that overrides the ::atomic accesses (e.g. with
+// critical sections) can provide matching ones. The default policy uses
+// std::atomic_ref (or the __atomic builtins) on the storage, which agrees
+// with lock-free ::atomic accesses.
+struct default_atomic_policy {
+    template <typename T>
+    static auto compare_exchange(T &t, T &expected, T desired, bool weak,
+                                 std::memory_order success,
+                                 std::memory_order failure) -> bool {
+#if __cpp_lib_atomic_ref >= 201806L
+        static_assert(alignof(T) >= std::atomic_ref<T>::required_alignment,
+                      "compare-exchange requires the storage to be aligned "
+                      "for std::atomic_ref");
+        auto ref = std::atomic_ref{t};
+        if (weak) {
+            return ref.compare_exchange_weak(expected, desired, success,
+                                             failure);
+        }
+        return ref.compare_exchange_strong(expected, desired, success,
+                                           failure);
+#else
+        // the memory_order values are the __ATOMIC_* constants
+        return __atomic_compare_exchange(&t, &expected, &desired, weak,
+                                         static_cast<int>(success),
+                                         static_cast<int>(failure));
+#endif
+    }
+
+    // without library support, waiting polls with ::atomic::load
+    template <typename T>
+    static auto wait(T const &t, T old, std::memory_order mo) -> void {
+#if __cpp_lib_atomic_wait >= 201907L and __cpp_lib_atomic_ref >= 201806L
+        // waiting does not modify t, but atomic_ref<T const> is not allowed
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        std::atomic_ref{const_cast<T &>(t)}.wait(old, mo);
+#else
+        while (::atomic::load(t, mo) == old) {
+            detail::cpu_relax();
+        }
+#endif
+    }
+
+    template <typename T>
+    static auto notify_one([[maybe_unused]] T &t) -> void {
+#if __cpp_lib_atomic_wait >= 201907L and __cpp_lib_atomic_ref >= 201806L
+        std::atomic_ref{t}.notify_one();
+#endif
+    }
+
+    template <typename T>
+    static auto notify_all([[maybe_unused]] T &t) -> void {
+#if __cpp_lib_atomic_wait >= 201907L and __cpp_lib_atomic_ref >= 201806L
+        std::atomic_ref{t}.notify_all();
+#endif
+    }
+};
+
+template <typename...> inline auto atomic_policy = default_atomic_policy{};
+
+namespace detail {
+template <typename... DummyArgs, typename T>
+auto atomic_compare_exchange(T &t, T &expected, T desired, bool weak,
+                             std::memory_order success,
+                             std::memory_order failure) -> bool {
+    return atomic_policy<DummyArgs...>.compare_exchange(
+        t, expected, desired, weak, success, failure);
+}
+
+template <typename... DummyArgs, typename T>
+auto atomic_wait(T const &t, T old, std::memory_order mo) -> void {
+    atomic_policy<DummyArgs...>.wait(t, old, mo);
+}
+
+template <typename... DummyArgs, typename T>
+auto atomic_notify_one(T &t) -> void {
+    atomic_policy<DummyArgs...>.notify_one(t);
+}
+
+template <typename... DummyArgs, typename T>
+auto atomic_notify_all(T &t) -> void {
+    atomic_policy<DummyArgs...>.notify_all(t);
+}
+} // namespace detail
+
+// Backoff policies for retry loops such as atomic<T>::fetch_update. Each is
+// called after a failed attempt; a fresh policy object is used for each call.
+struct no_backoff {
+    auto operator()() -> void {}
+};
+
+struct pause_backoff {
+    auto operator()() -> void { detail::cpu_relax(); }
+};
+
+// pauses 1, 2, 4, ... times, up to MaxPauses
+template <unsigned MaxPauses = 64> struct exponential_backoff {
+    unsigned pauses{1};
+    auto operator()() -> void {
+        for (auto i = 0u; i < pauses; ++i) {
+            detail::cpu_relax();
+        }
+        pauses = pauses < MaxPauses ? pauses * 2 : MaxPauses;
+    }
+};
+
+#if __has_include(<thread>)
+struct yield_backoff {
+    auto operator()() -> void { std::this_thread::yield(); }
+};
+#endif
+
 // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
 template <typename T> class atomic {
     static_assert(std::is_trivially_copyable_v<T> and
@@ -116,6 +251,60 @@ template <typename T> class atomic {
     auto operator&=(T t) -> T { return fetch_and(t) & t; }
     auto operator|=(T t) -> T { return fetch_or(t) | t; }
     auto operator^=(T t) -> T { return fetch_xor(t) ^ t; }
+
+    auto compare_exchange_weak(T &expected, T desired,
+                               std::memory_order success,
+                               std::memory_order failure) -> bool {
+        return compare_exchange(expected, desired, true, success, failure);
+    }
+    auto compare_exchange_weak(
+        T &expected, T desired,
+        std::memory_order mo = std::memory_order_seq_cst) -> bool {
+        return compare_exchange(expected, desired, true, mo,
+                                detail::failure_order(mo));
+    }
+    auto compare_exchange_strong(T &expected, T desired,
+                                 std::memory_order success,
+                                 std::memory_order failure) -> bool {
+        return compare_exchange(expected, desired, false, success, failure);
+    }
+    auto compare_exchange_strong(
+        T &expected, T desired,
+        std::memory_order mo = std::memory_order_seq_cst) -> bool {
+        return compare_exchange(expected, desired, false, mo,
+                                detail::failure_order(mo));
+    }
+
+    // Atomically replaces the value v with f(v), retrying with backoff while
+    // other threads change it first, and returns the previous value.
+    template <typename F, typename Backoff = pause_backoff>
+    auto fetch_update(F &&f, std::memory_order mo = std::memory_order_seq_cst,
+                      Backoff backoff = {}) -> T {
+        auto old = load(std::memory_order_relaxed);
+        while (not compare_exchange_weak(old, static_cast<T>(f(old)), mo,
+                                         std::memory_order_relaxed)) {
+            backoff();
+        }
+        return old;
+    }
+
+    auto wait(T old, std::memory_order mo = std::memory_order_seq_cst) const
+        -> void {
+        detail::atomic_wait(value, static_cast<elem_t>(old), mo);
+    }
+    auto notify_one() -> void { detail::atomic_notify_one(value); }
+    auto notify_all() -> void { detail::atomic_notify_all(value); }
+
+  private:
+    auto compare_exchange(T &expected, T desired, bool weak,
+                          std::memory_order success,
+                          std::memory_order failure) -> bool {
+        auto e = static_cast<elem_t>(expected);
+        auto const r = detail::atomic_compare_exchange(
+            value, e, static_cast<elem_t>(desired), weak, success, failure);
+        expected = static_cast<T>(e);
+        return r;
+    }
 };
 } // namespace v1
 } // namespace stdx
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdx/atomic.hpp>
 #include <stdx/bit.hpp>
 #include <stdx/bitset.hpp>
 #include <stdx/compiler.hpp>
@@ -12,16 +13,180 @@
 #include <conc/atomic.hpp>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <limits>
 #include <string_view>
 
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+
+// The size of the cache line used to separate the shards of a sharded
+// atomic_bitset. By default it is the value the compiler uses for
+// std::hardware_destructive_interference_size (which GCC warns about using
+// directly in a header), or 64.
+#ifndef STDX_CACHE_LINE_SIZE
+#ifdef __GCC_DESTRUCTIVE_SIZE
+#define STDX_CACHE_LINE_SIZE __GCC_DESTRUCTIVE_SIZE
+#else
+#define STDX_CACHE_LINE_SIZE 64
+#endif
+#endif
+
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
 namespace stdx {
 inline namespace v1 {
+// How an atomic_bitset of more than one word reads the whole set. With
+// no_snapshot, each word is loaded atomically but the words may be seen at
+// different times. With seqlock_snapshot, writers also bump a pair of
+// sequence counters and whole-set reads retry until they see a consistent
+// set of words; memory orders are strengthened to at least release (writes)
+// and acquire (reads).
+struct no_snapshot {};
+struct seqlock_snapshot {};
+
+// How an atomic_bitset lays out its words. packed_layout puts them next to
+// each other. sharded_layout puts each group of WordsPerShard words on its own
+// cache line, so that threads updating bits in different shards do not
+// contend for the same line.
+struct packed_layout {};
+template <std::size_t WordsPerShard = 1> struct sharded_layout {
+    static_assert(WordsPerShard > 0, "A shard must hold at least one word");
+};
+
+namespace detail {
+template <typename T>
+concept snapshot_policy =
+    std::same_as<T, no_snapshot> or std::same_as<T, seqlock_snapshot>;
+
+template <typename> constexpr auto is_sharded_layout = false;
+template <std::size_t W>
+constexpr auto is_sharded_layout<sharded_layout<W>> = true;
+
+template <typename T>
+concept word_layout = std::same_as<T, packed_layout> or is_sharded_layout<T>;
+
+constexpr inline auto cache_line_size = std::size_t{STDX_CACHE_LINE_SIZE};
+
+template <typename Layout, typename T, std::size_t N, std::size_t Align>
+struct atomic_words {
+    alignas(Align) std::array<T, N> words{};
+
+    constexpr atomic_words() = default;
+    constexpr explicit atomic_words(std::array<T, N> const &ws) : words{ws} {}
+
+    constexpr auto operator[](std::size_t i) -> T & { return words[i]; }
+    constexpr auto operator[](std::size_t i) const -> T const & {
+        return words[i];
+    }
+};
+
+template <std::size_t W, typename T, std::size_t N, std::size_t Align>
+struct atomic_words<sharded_layout<W>, T, N, Align> {
+    struct alignas(std::max(cache_line_size, Align)) shard {
+        std::array<T, W> words{};
+    };
+    std::array<shard, (N + W - 1) / W> shards{};
+
+    constexpr atomic_words() = default;
+    constexpr explicit atomic_words(std::array<T, N> const &ws) {
+        for (auto i = std::size_t{}; i < N; ++i) {
+            (*this)[i] = ws[i];
+        }
+    }
+
+    constexpr auto operator[](std::size_t i) -> T & {
+        return shards[i / W].words[i % W];
+    }
+    constexpr auto operator[](std::size_t i) const -> T const & {
+        return shards[i / W].words[i % W];
+    }
+};
+
+template <typename> struct snapshot_guard {
+    auto begin_write() -> void {}
+    auto end_write() -> void {}
+    template <typename F> auto read(F &&f) const { return f(); }
+
+    constexpr static auto write_order(std::memory_order order) {
+        return order;
+    }
+    constexpr static auto read_order(std::memory_order order) {
+        return order;
+    }
+};
+
+// Writers increment begun before, and ended after, modifying the words.
+// Word writes are at least release and word reads at least acquire, so a
+// reader that sees any word written by a writer also sees its increment of
+// begun. Reads retry unless begun (read after the words) matches ended (read
+// before them): then no write overlapped the reads.
+template <> struct snapshot_guard<seqlock_snapshot> {
+    using counter_t = ::atomic::atomic_type_t<std::uint32_t>;
+    counter_t begun{};
+    counter_t ended{};
+
+    auto begin_write() -> void {
+        ::atomic::fetch_add(begun, 1u, std::memory_order_relaxed);
+    }
+    auto end_write() -> void {
+        ::atomic::fetch_add(ended, 1u, std::memory_order_release);
+    }
+
+    template <typename F> auto read(F &&f) const {
+        while (true) {
+            auto const e = ::atomic::load(ended, std::memory_order_acquire);
+            auto r = f();
+            if (::atomic::load(begun, std::memory_order_relaxed) == e) {
+                return r;
+            }
+        }
+    }
+
+    constexpr static auto write_order(std::memory_order order) {
+        switch (order) {
+        case std::memory_order_relaxed: return std::memory_order_release;
+        case std::memory_order_consume:
+        case std::memory_order_acquire: return std::memory_order_acq_rel;
+        default: return order;
+        }
+    }
+    constexpr static auto read_order(std::memory_order order) {
+        switch (order) {
+        case std::memory_order_relaxed:
+        case std::memory_order_consume: return std::memory_order_acquire;
+        default: return order;
+        }
+    }
+};
+
+// waiters poll this many times before parking
+constexpr inline auto wait_spins = 64;
+
+// Waiters on a multi-word atomic_bitset wait on an epoch counter that notify
+// increments. Counters are shared between bitsets through a small table
+// indexed by address; a collision only causes a spurious wakeup.
+struct alignas(cache_line_size) wait_epoch {
+    ::atomic::atomic_type_t<std::uint32_t> value{};
+};
+constexpr inline auto num_wait_epochs = std::size_t{16};
+inline std::array<wait_epoch, num_wait_epochs> wait_epochs{};
+
+[[nodiscard]] inline auto epoch_for(void const *p)
+    -> ::atomic::atomic_type_t<std::uint32_t> & {
+    auto const a = reinterpret_cast<std::uintptr_t>(p) / cache_line_size;
+    return wait_epochs[a % num_wait_epochs].value;
+}
+} // namespace detail
+
 template <auto Size,
-          typename StorageElem = decltype(smallest_uint<to_underlying(Size)>())>
+          typename StorageElem = decltype(smallest_uint<to_underlying(Size)>()),
+          detail::snapshot_policy Snapshot = no_snapshot,
+          detail::word_layout Layout = packed_layout>
 class atomic_bitset {
     constexpr static std::size_t N = to_underlying(Size);
 
@@ -32,53 +197,133 @@ class atomic_bitset {
                   "Storage element for atomic_bitset must be an unsigned type");
 
     constexpr static auto bit = elem_t{1U};
+    constexpr static auto storage_elem_size =
+        std::size_t{std::numeric_limits<elem_t>::digits};
+    constexpr static auto storage_size =
+        (N + storage_elem_size - 1) / storage_elem_size;
+    constexpr static auto allbits = std::numeric_limits<elem_t>::max();
+    constexpr static auto lastmask =
+        bit_mask<elem_t, (N - 1) % storage_elem_size>();
+
+    using words_t = std::array<elem_t, storage_size>;
+    using bitset_t = bitset<Size, elem_t>;
+
+    detail::atomic_words<Layout, elem_t, storage_size, alignment> storage{};
+    [[no_unique_address]] detail::snapshot_guard<Snapshot> guard{};
 
-    static_assert(N <= std::numeric_limits<elem_t>::digits,
-                  "atomic_bitset is limited to a single storage element");
-    alignas(alignment) elem_t storage{};
-
-    constexpr static auto mask = bit_mask<elem_t, N - 1>();
-    auto salient_value(std::memory_order order) const -> elem_t {
-        return ::atomic::load(storage, order) & mask;
-    }
-
-    [[nodiscard]] constexpr static auto value_from_string(std::string_view str,
-                                                          std::size_t pos,
-                                                          std::size_t n,
-                                                          char one) -> elem_t {
-        elem_t ret{};
-        auto const len = std::min(n, str.size() - pos);
-        auto const s = str.substr(pos, std::min(len, N));
-        auto i = bit;
-        // NOLINTNEXTLINE(modernize-loop-convert)
-        for (auto it = std::rbegin(s); it != std::rend(s); ++it) {
-            if (*it == one) {
-                ret |= i;
+    [[nodiscard]] constexpr static auto word_mask(std::size_t i) -> elem_t {
+        return i == storage_size - 1 ? lastmask : allbits;
+    }
+
+    [[nodiscard]] constexpr static auto words_of(bitset_t const &b)
+        -> words_t {
+        auto const *data = detail::bitset_access::words(b);
+        words_t words{};
+        for (auto i = std::size_t{}; i < storage_size; ++i) {
+            words[i] = data[i] & word_mask(i);
+        }
+        return words;
+    }
+
+    [[nodiscard]] static auto to_bitset(words_t const &words) -> bitset_t {
+        bitset_t b{};
+        auto *data = detail::bitset_access::words(b);
+        for (auto i = std::size_t{}; i < storage_size; ++i) {
+            data[i] = words[i];
+        }
+        return b;
+    }
+
+    auto salient_words(std::memory_order order) const -> words_t {
+        order = guard.read_order(order);
+        return guard.read([&] {
+            words_t words{};
+            for (auto i = std::size_t{}; i < storage_size; ++i) {
+                words[i] = ::atomic::load(storage[i], order) & word_mask(i);
             }
-            i = static_cast<elem_t>(i << 1u);
+            return words;
+        });
+    }
+
+    // Applies op(word, mask, order) to the words holding bits lsb to msb, and
+    // returns the previous values of those words (other words are zero).
+    template <typename Op>
+    auto modify(std::size_t lsb, std::size_t msb, std::memory_order order,
+                Op op) -> bitset_t {
+        order = guard.write_order(order);
+        auto const lw = lsb / storage_elem_size;
+        auto const mw = msb / storage_elem_size;
+        words_t prev{};
+        guard.begin_write();
+        for (auto i = lw; i <= mw; ++i) {
+            auto const l = i == lw ? lsb % storage_elem_size : 0;
+            auto const m =
+                i == mw ? msb % storage_elem_size : storage_elem_size - 1;
+            prev[i] =
+                op(storage[i], bit_mask<elem_t>(m, l), order) & word_mask(i);
         }
-        return ret;
+        guard.end_write();
+        return to_bitset(prev);
     }
 
-    using bitset_t = bitset<Size, elem_t>;
+    template <typename Op> auto store_all(Op op, std::memory_order order) {
+        order = guard.write_order(order);
+        guard.begin_write();
+        for (auto i = std::size_t{}; i < storage_size; ++i) {
+            ::atomic::store(storage[i], op(i), order);
+        }
+        guard.end_write();
+    }
+
+    // Blocks until pred(words) is true for the salient words: polls briefly
+    // (pausing between polls), then parks until a notify. A single word is
+    // waited on directly; more words wait on an epoch that notify increments.
+    template <typename Pred>
+    auto wait_until(Pred pred, std::memory_order order) const -> bitset_t {
+        for (auto spins = 0;; ++spins) {
+            if constexpr (storage_size == 1) {
+                auto const w = ::atomic::load(storage[0], order);
+                auto const words = words_t{static_cast<elem_t>(w & lastmask)};
+                if (pred(words)) {
+                    return to_bitset(words);
+                }
+                if (spins < detail::wait_spins) {
+                    detail::cpu_relax();
+                } else {
+                    detail::atomic_wait(storage[0], w, order);
+                }
+            } else {
+                auto const &epoch = detail::epoch_for(this);
+                auto const e = ::atomic::load(epoch, std::memory_order_acquire);
+                auto const words = salient_words(order);
+                if (pred(words)) {
+                    return to_bitset(words);
+                }
+                if (spins < detail::wait_spins) {
+                    detail::cpu_relax();
+                } else {
+                    detail::atomic_wait(epoch, e, std::memory_order_acquire);
+                }
+            }
+        }
+    }
 
   public:
     constexpr atomic_bitset() = default;
     constexpr explicit atomic_bitset(std::uint64_t value)
-        : storage{static_cast<elem_t>(value & mask)} {}
+        : storage{words_of(bitset_t{value})} {}
 
     template <typename... Bs>
     constexpr explicit atomic_bitset(place_bits_t, Bs... bs)
-        : storage{static_cast<elem_t>(
-              (elem_t{} | ... |
-               static_cast<elem_t>(bit << to_underlying(bs))))} {}
+        : storage{words_of(bitset_t{place_bits, bs...})} {}
 
-    constexpr explicit atomic_bitset(all_bits_t) : storage{mask} {}
+    constexpr explicit atomic_bitset(all_bits_t)
+        : storage{words_of(bitset_t{all_bits})} {}
 
     constexpr explicit atomic_bitset(std::string_view str, std::size_t pos = 0,
                                      std::size_t n = std::string_view::npos,
                                      char one = '1')
-        : storage{value_from_string(str, pos, n, one)} {}
+        : storage{words_of(bitset_t{str, pos, n, one})} {}
 
     constexpr explicit atomic_bitset(ct_string<N + 1> s)
         : atomic_bitset{static_cast<std::string_view>(s)} {}
@@ -92,56 +337,66 @@ class atomic_bitset {
             "Conversion must be to an unsigned integral type or enum!");
         static_assert(N <= std::numeric_limits<U>::digits,
                       "atomic_bitset must fit within T");
-        return static_cast<T>(salient_value(order));
+        return load(order).template to<T>();
     }
 
     [[nodiscard]] auto
-    to_natural(std::memory_order order = std::memory_order_seq_cst) const
-        -> StorageElem {
-        return static_cast<StorageElem>(salient_value(order));
+    to_natural(std::memory_order order = std::memory_order_seq_cst) const {
+        if constexpr (storage_size == 1) {
+            return static_cast<StorageElem>(salient_words(order)[0]);
+        } else {
+            return load(order).to_natural();
+        }
     }
 
     // NOLINTNEXTLINE(google-explicit-constructor)
-    operator bitset_t() const {
-        return bitset_t{salient_value(std::memory_order_seq_cst)};
-    }
+    operator bitset_t() const { return load(); }
 
+    // With more than one word, the words are loaded one at a time, and unless
+    // Snapshot is seqlock_snapshot, they may not be a consistent snapshot.
     auto load(std::memory_order order = std::memory_order_seq_cst) const
         -> bitset_t {
-        return bitset_t{salient_value(order)};
+        return to_bitset(salient_words(order));
     }
     auto store(bitset_t b,
                std::memory_order order = std::memory_order_seq_cst) {
-        ::atomic::store(storage, b.template to<elem_t>(), order);
+        auto const words = words_of(b);
+        store_all([&](auto i) { return words[i]; }, order);
     }
 
     constexpr static std::integral_constant<std::size_t, N> size{};
 
     template <typename T> [[nodiscard]] auto operator[](T idx) const -> bool {
-        return load()[idx];
+        auto const pos = static_cast<std::size_t>(to_underlying(idx));
+        return (::atomic::load(storage[pos / storage_elem_size]) >>
+                (pos % storage_elem_size)) &
+               1u;
     }
 
+    // Operations on bits or ranges of bits touch only the words containing
+    // them, with one read-modify-write per word. They return the previous
+    // values of those words; any other words in the result are zero.
     template <typename T>
     auto set(T idx, bool value = true,
              std::memory_order order = std::memory_order_seq_cst) -> bitset_t {
         auto const pos = static_cast<std::size_t>(to_underlying(idx));
         if (value) {
-            return bitset_t{::atomic::fetch_or(
-                storage, static_cast<elem_t>(bit << pos), order)};
+            return modify(pos, pos, order, [](auto &w, auto m, auto o) {
+                return ::atomic::fetch_or(w, m, o);
+            });
         }
-        return bitset_t{::atomic::fetch_and(
-            storage, static_cast<elem_t>(~(bit << pos)), order)};
+        return reset(idx, order);
     }
 
     auto set(lsb_t lsb, msb_t msb, bool value = true,
              std::memory_order order = std::memory_order_seq_cst) -> bitset_t {
-        auto const l = to_underlying(lsb);
-        auto const m = to_underlying(msb);
-        auto const shifted_value = bit_mask<elem_t>(m, l);
         if (value) {
-            return bitset_t{::atomic::fetch_or(storage, shifted_value, order)};
+            return modify(to_underlying(lsb), to_underlying(msb), order,
+                          [](auto &w, auto m, auto o) {
+                              return ::atomic::fetch_or(w, m, o);
+                          });
         }
-        return bitset_t{::atomic::fetch_and(storage, ~shifted_value, order)};
+        return reset(lsb, msb, order);
     }
 
     auto set(lsb_t lsb, length_t len, bool value = true,
@@ -153,7 +408,7 @@ class atomic_bitset {
 
     auto set(std::memory_order order = std::memory_order_seq_cst) LIFETIMEBOUND
         -> atomic_bitset & {
-        ::atomic::store(storage, mask, order);
+        store_all([](auto i) { return word_mask(i); }, order);
         return *this;
     }
 
@@ -161,17 +416,19 @@ class atomic_bitset {
     auto reset(T idx, std::memory_order order = std::memory_order_seq_cst)
         -> bitset_t {
         auto const pos = static_cast<std::size_t>(to_underlying(idx));
-        return bitset_t{::atomic::fetch_and(
-            storage, static_cast<elem_t>(~(bit << pos)), order)};
+        return modify(pos, pos, order, [](auto &w, auto m, auto o) {
+            return ::atomic::fetch_and(w, static_cast<elem_t>(~m), o);
+        });
     }
 
     auto reset(lsb_t lsb, msb_t msb,
                std::memory_order order = std::memory_order_seq_cst)
         -> bitset_t {
-        auto const l = to_underlying(lsb);
-        auto const m = to_underlying(msb);
-        auto const shifted_value = bit_mask<elem_t>(m, l);
-        return bitset_t{::atomic::fetch_and(storage, ~shifted_value, order)};
+        return modify(to_underlying(lsb), to_underlying(msb), order,
+                      [](auto &w, auto m, auto o) {
+                          return ::atomic::fetch_and(
+                              w, static_cast<elem_t>(~m), o);
+                      });
     }
 
     auto reset(lsb_t lsb, length_t len,
@@ -185,7 +442,7 @@ class atomic_bitset {
     auto
     reset(std::memory_order order = std::memory_order_seq_cst) LIFETIMEBOUND
         -> atomic_bitset & {
-        ::atomic::store(storage, elem_t{}, order);
+        store_all([](auto) { return elem_t{}; }, order);
         return *this;
     }
 
@@ -193,16 +450,17 @@ class atomic_bitset {
     auto flip(T idx, std::memory_order order = std::memory_order_seq_cst)
         -> bitset_t {
         auto const pos = static_cast<std::size_t>(to_underlying(idx));
-        return bitset_t{::atomic::fetch_xor(
-            storage, static_cast<elem_t>(bit << pos), order)};
+        return modify(pos, pos, order, [](auto &w, auto m, auto o) {
+            return ::atomic::fetch_xor(w, m, o);
+        });
     }
 
     auto flip(lsb_t lsb, msb_t msb,
               std::memory_order order = std::memory_order_seq_cst) -> bitset_t {
-        auto const l = to_underlying(lsb);
-        auto const m = to_underlying(msb);
-        auto const shifted_value = bit_mask<elem_t>(m, l);
-        return bitset_t{::atomic::fetch_xor(storage, shifted_value, order)};
+        return modify(to_underlying(lsb), to_underlying(msb), order,
+                      [](auto &w, auto m, auto o) {
+                          return ::atomic::fetch_xor(w, m, o);
+                      });
     }
 
     auto flip(lsb_t lsb, length_t len,
@@ -213,29 +471,135 @@ class atomic_bitset {
     }
 
     auto flip(std::memory_order order = std::memory_order_seq_cst) -> bitset_t {
-        return bitset_t{::atomic::fetch_xor(storage, mask, order)};
+        return flip(lsb_t{}, static_cast<msb_t>(N - 1), order);
+    }
+
+    // Sets an unset bit and returns its index, or size() if every bit is set.
+    // The search starts at word start_word (modulo the number of words) and
+    // wraps around; within a word the lowest unset bit is taken. Each attempt
+    // is one fetch_or, retried with the value it returns if another thread
+    // took the bit first.
+    auto acquire_lowest_unset(
+        std::size_t start_word = 0,
+        std::memory_order order = std::memory_order_seq_cst) -> std::size_t {
+        order = guard.write_order(order);
+        for (auto n = std::size_t{}; n < storage_size; ++n) {
+            auto const i = (start_word + n) % storage_size;
+            auto unset = static_cast<elem_t>(
+                ~::atomic::load(storage[i], std::memory_order_relaxed) &
+                word_mask(i));
+            while (unset != 0) {
+                auto const pos = static_cast<std::size_t>(countr_zero(unset));
+                auto const b = static_cast<elem_t>(bit << pos);
+                guard.begin_write();
+                auto const prev = ::atomic::fetch_or(storage[i], b, order);
+                guard.end_write();
+                if ((prev & b) == 0) {
+                    return i * storage_elem_size + pos;
+                }
+                unset = static_cast<elem_t>(~prev & word_mask(i));
+            }
+        }
+        return N;
+    }
+
+    // Block until any (or all) of the bits in mask are set, and return the
+    // value seen. Writers must call notify_one or notify_all after changing
+    // bits to wake waiters. With more than one word, wait_all sees all the
+    // bits set in one load (which is a snapshot only with seqlock_snapshot).
+    auto wait_any(bitset_t const &mask,
+                  std::memory_order order = std::memory_order_seq_cst) const
+        -> bitset_t {
+        auto const m = words_of(mask);
+        return wait_until(
+            [&](words_t const &words) {
+                for (auto i = std::size_t{}; i < storage_size; ++i) {
+                    if ((words[i] & m[i]) != 0) {
+                        return true;
+                    }
+                }
+                return false;
+            },
+            order);
+    }
+
+    auto wait_all(bitset_t const &mask,
+                  std::memory_order order = std::memory_order_seq_cst) const
+        -> bitset_t {
+        auto const m = words_of(mask);
+        return wait_until(
+            [&](words_t const &words) {
+                for (auto i = std::size_t{}; i < storage_size; ++i) {
+                    if ((words[i] & m[i]) != m[i]) {
+                        return false;
+                    }
+                }
+                return true;
+            },
+            order);
     }
 
+    auto notify_one() -> void {
+        if constexpr (storage_size == 1) {
+            detail::atomic_notify_one(storage[0]);
+        } else {
+            // the epoch may be shared, so waking one waiter could wake the
+            // wrong one
+            auto &epoch = detail::epoch_for(this);
+            ::atomic::fetch_add(epoch, 1u, std::memory_order_release);
+            detail::atomic_notify_all(epoch);
+        }
+    }
+
+    auto notify_all() -> void {
+        if constexpr (storage_size == 1) {
+            detail::atomic_notify_all(storage[0]);
+        } else {
+            auto &epoch = detail::epoch_for(this);
+            ::atomic::fetch_add(epoch, 1u, std::memory_order_release);
+            detail::atomic_notify_all(epoch);
+        }
+    }
+
+    // Like load, these read the words one at a time: see Snapshot.
     [[nodiscard]] auto
     all(std::memory_order order = std::memory_order_seq_cst) const -> bool {
-        return salient_value(order) == mask;
+        auto const words = salient_words(order);
+        for (auto i = std::size_t{}; i < storage_size; ++i) {
+            if (words[i] != word_mask(i)) {
+                return false;
+            }
+        }
+        return true;
     }
     [[nodiscard]] auto
     any(std::memory_order order = std::memory_order_seq_cst) const -> bool {
-        return salient_value(order) != 0;
+        auto const words = salient_words(order);
+        return std::any_of(std::cbegin(words), std::cend(words),
+                           [](auto w) { return w != 0; });
     }
     [[nodiscard]] auto
     none(std::memory_order order = std::memory_order_seq_cst) const -> bool {
-        return salient_value(order) == 0;
+        return not any(order);
     }
 
     [[nodiscard]] auto
     count(std::memory_order order = std::memory_order_seq_cst) const
         -> std::size_t {
-        return static_cast<std::size_t>(popcount(salient_value(order)));
+        auto n = std::size_t{};
+        for (auto w : salient_words(order)) {
+            n += static_cast<std::size_t>(popcount(w));
+        }
+        return n;
     }
 };
 
 template <std::size_t N> atomic_bitset(ct_string<N>) -> atomic_bitset<N - 1>;
+
+template <auto Size,
+          typename StorageElem = decltype(smallest_uint<to_underlying(Size)>()),
+          detail::snapshot_policy Snapshot = no_snapshot>
+using sharded_atomic_bitset =
+    atomic_bitset<Size, StorageElem, Snapshot, sharded_layout<>>;
 } // namespace v1
 } // namespace stdx
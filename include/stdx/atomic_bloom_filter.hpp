@@ -0,0 +1,125 @@
+#pragma once
+
+#include <stdx/atomic.hpp>
+#include <stdx/bitset.hpp>
+#include <stdx/bloom_filter.hpp>
+#include <stdx/span.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace stdx {
+inline namespace v1 {
+// A blocked Bloom filter that may be inserted into and queried concurrently.
+// It uses the same layout and hashing as bloom_filter, so it can start from a
+// bloom_filter built at compile time.
+template <std::size_t Bits, std::size_t Hashes, typename Hash = bloom_hash>
+class atomic_bloom_filter {
+    using filter_t = bloom_filter<Bits, Hashes, Hash>;
+    constexpr static auto num_blocks = Bits / detail::bloom::block_bits;
+    constexpr static auto num_words = Bits / 64;
+
+    alignas(64) std::array<atomic<std::uint64_t>, num_words> storage{};
+    [[no_unique_address]] Hash hash{};
+
+    template <typename K>
+    [[nodiscard]] auto probe_for(K const &key) const {
+        return detail::bloom::make_probe<num_blocks, Hashes>(hash(key));
+    }
+
+    auto apply(detail::bloom::probe const &p, std::memory_order mo) -> void {
+        for (auto w = std::size_t{}; w < detail::bloom::block_words; ++w) {
+            if (p.masks[w] != 0) {
+                storage[p.first_word + w].fetch_or(p.masks[w], mo);
+            }
+        }
+    }
+
+    [[nodiscard]] auto test(detail::bloom::probe const &p,
+                            std::memory_order mo) const -> bool {
+        for (auto w = std::size_t{}; w < detail::bloom::block_words; ++w) {
+            if ((storage[p.first_word + w].load(mo) & p.masks[w]) !=
+                p.masks[w]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename K, std::size_t Extent, typename F>
+    auto for_each_probe(span<K, Extent> keys, F &&f) const -> void {
+        std::array<detail::bloom::probe, detail::bloom::batch_size> probes{};
+        for (auto i = std::size_t{}; i < std::size(keys);
+             i += detail::bloom::batch_size) {
+            auto const n =
+                std::min(detail::bloom::batch_size, std::size(keys) - i);
+            for (auto j = std::size_t{}; j < n; ++j) {
+                probes[j] = probe_for(keys[i + j]);
+                detail::bloom::prefetch(&storage[probes[j].first_word]);
+            }
+            for (auto j = std::size_t{}; j < n; ++j) {
+                f(i + j, probes[j]);
+            }
+        }
+    }
+
+  public:
+    atomic_bloom_filter() = default;
+    explicit atomic_bloom_filter(Hash h) : hash{std::move(h)} {}
+
+    explicit atomic_bloom_filter(filter_t const &f, Hash h = {})
+        : hash{std::move(h)} {
+        auto const *words = detail::bitset_access::words(f.bits());
+        for (auto i = std::size_t{}; i < num_words; ++i) {
+            storage[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    constexpr static std::integral_constant<std::size_t, Bits> capacity{};
+    constexpr static std::integral_constant<std::size_t, Hashes> hashes{};
+
+    template <typename K>
+    auto insert(K const &key,
+                std::memory_order mo = std::memory_order_seq_cst) -> void {
+        apply(probe_for(key), mo);
+    }
+
+    template <typename K, std::size_t Extent>
+    auto insert(span<K, Extent> keys,
+                std::memory_order mo = std::memory_order_seq_cst) -> void {
+        for_each_probe(keys, [&](auto, auto const &p) { apply(p, mo); });
+    }
+
+    template <typename K>
+    [[nodiscard]] auto
+    may_contain(K const &key,
+                std::memory_order mo = std::memory_order_seq_cst) const
+        -> bool {
+        return test(probe_for(key), mo);
+    }
+
+    template <typename K, std::size_t Extent, std::size_t OutExtent>
+    auto may_contain(span<K, Extent> keys, span<bool, OutExtent> out,
+                     std::memory_order mo = std::memory_order_seq_cst) const
+        -> std::size_t {
+        auto n = std::size_t{};
+        for_each_probe(keys, [&](auto i, auto const &p) {
+            out[i] = test(p, mo);
+            n += out[i] ? 1u : 0u;
+        });
+        return n;
+    }
+
+    // not atomic as a whole: concurrent inserts may survive
+    auto clear(std::memory_order mo = std::memory_order_seq_cst) -> void {
+        for (auto &w : storage) {
+            w.store(0, mo);
+        }
+    }
+};
+} // namespace v1
+} // namespace stdx
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <stdx/bitset.hpp>
+#include <stdx/compiler.hpp>
+#include <stdx/detail/simd.hpp>
+#include <stdx/type_traits.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace stdx {
+inline namespace v1 {
+// A Rows x Cols matrix of bits, held as Rows bitsets of Cols bits. Row i,
+// column j is the edge i -> j of a graph. Everything is constexpr; at runtime
+// the row operations and the 64x64 transpose tiles are vectorized.
+template <std::size_t Rows, std::size_t Cols> class bit_matrix {
+    static_assert(Rows > 0 and Cols > 0,
+                  "bit_matrix must have at least one row and one column");
+
+  public:
+    using row_t = bitset<Cols, std::uint64_t>;
+
+  private:
+    constexpr static auto tile_size = std::size_t{64};
+
+    std::array<row_t, Rows> storage{};
+
+    template <std::size_t, std::size_t> friend class bit_matrix;
+
+  public:
+    constexpr bit_matrix() = default;
+    constexpr explicit bit_matrix(std::array<row_t, Rows> const &rows)
+        : storage{rows} {}
+
+    [[nodiscard]] constexpr static auto identity() -> bit_matrix {
+        static_assert(Rows == Cols, "identity() requires a square matrix");
+        bit_matrix m{};
+        for (auto i = std::size_t{}; i < Rows; ++i) {
+            m.storage[i].set(i);
+        }
+        return m;
+    }
+
+    constexpr static std::integral_constant<std::size_t, Rows> num_rows{};
+    constexpr static std::integral_constant<std::size_t, Cols> num_cols{};
+
+    [[nodiscard]] constexpr auto row(std::size_t r) LIFETIMEBOUND -> row_t & {
+        return storage[r];
+    }
+    [[nodiscard]] constexpr auto row(std::size_t r) const LIFETIMEBOUND
+        -> row_t const & {
+        return storage[r];
+    }
+
+    [[nodiscard]] constexpr auto get(std::size_t r, std::size_t c) const
+        -> bool {
+        return storage[r][c];
+    }
+
+    constexpr auto set(std::size_t r, std::size_t c,
+                       bool value = true) LIFETIMEBOUND -> bit_matrix & {
+        storage[r].set(c, value);
+        return *this;
+    }
+
+    constexpr auto reset(std::size_t r, std::size_t c) LIFETIMEBOUND
+        -> bit_matrix & {
+        storage[r].reset(c);
+        return *this;
+    }
+
+    // the OR of the rows selected by sel: the vector-matrix product sel * M
+    template <auto Size, typename S>
+    [[nodiscard]] constexpr auto or_rows(bitset<Size, S> const &sel) const
+        -> row_t {
+        static_assert(to_underlying(Size) == Rows,
+                      "Selection must have one bit per row");
+        row_t acc{};
+        stdx::for_each([&](auto r) { acc |= storage[r]; }, sel);
+        return acc;
+    }
+
+    // works in 64x64 tiles, each transposed in place in a local buffer
+    [[nodiscard]] constexpr auto transpose() const -> bit_matrix<Cols, Rows> {
+        bit_matrix<Cols, Rows> result{};
+        for (auto rb = std::size_t{}; rb < Rows; rb += tile_size) {
+            auto const tile_rows = std::min(tile_size, Rows - rb);
+            for (auto cb = std::size_t{}; cb < Cols; cb += tile_size) {
+                auto const tile_cols = std::min(tile_size, Cols - cb);
+                std::array<std::uint64_t, tile_size> tile{};
+                for (auto k = std::size_t{}; k < tile_rows; ++k) {
+                    tile[k] =
+                        detail::bitset_access::words(storage[rb + k])[cb / 64];
+                }
+                detail::simd::transpose64(std::data(tile));
+                for (auto k = std::size_t{}; k < tile_cols; ++k) {
+                    detail::bitset_access::words(
+                        result.storage[cb + k])[rb / 64] = tile[k];
+                }
+            }
+        }
+        return result;
+    }
+
+    // Warshall's algorithm: after step k, row i has every vertex reachable
+    // from i through intermediate vertices up to k
+    [[nodiscard]] constexpr auto transitive_closure() const -> bit_matrix {
+        static_assert(Rows == Cols,
+                      "transitive_closure() requires a square matrix");
+        auto m = *this;
+        for (auto k = std::size_t{}; k < Rows; ++k) {
+            for (auto &r : m.storage) {
+                if (r[k]) {
+                    r |= m.storage[k];
+                }
+            }
+        }
+        return m;
+    }
+
+    // the boolean product: row i of the result is the OR of the rows of rhs
+    // selected by row i of lhs
+    template <std::size_t K>
+    [[nodiscard]] friend constexpr auto
+    operator*(bit_matrix const &lhs, bit_matrix<Cols, K> const &rhs)
+        -> bit_matrix<Rows, K> {
+        bit_matrix<Rows, K> result{};
+        for (auto i = std::size_t{}; i < Rows; ++i) {
+            result.row(i) = rhs.or_rows(lhs.storage[i]);
+        }
+        return result;
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(bit_matrix const &lhs,
+                                                   bit_matrix const &rhs)
+        -> bool = default;
+};
+} // namespace v1
+} // namespace stdx
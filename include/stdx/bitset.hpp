@@ -5,6 +5,8 @@
 #include <stdx/concepts.hpp>
 #include <stdx/ct_string.hpp>
 #include <stdx/detail/bitset_common.hpp>
+#include <stdx/detail/simd.hpp>
+#include <stdx/span.hpp>
 #include <stdx/type_traits.hpp>
 #include <stdx/udls.hpp>
 
@@ -12,8 +14,11 @@
 
 #include <algorithm>
 #include <array>
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <limits>
 #include <string_view>
 #include <type_traits>
@@ -21,44 +26,12 @@
 
 namespace stdx {
 inline namespace v1 {
-struct set_bit {
-    template <auto Bit, typename IterArg, auto Mask>
-    constexpr static auto fn(auto e, auto idx, auto &f) {
-        using elem_t = decltype(Bit);
-        while (e != 0) {
-            auto const offset = static_cast<std::size_t>(countr_zero(e));
-            e &= static_cast<elem_t>(~(Bit << offset));
-            f(static_cast<IterArg>(idx + offset));
-        }
-    }
-};
-struct unset_bit {
-    template <auto Bit, typename IterArg, auto Mask>
-    constexpr static auto fn(auto e, auto idx, auto &f) {
-        using elem_t = decltype(Bit);
-        while (e != Mask) {
-            auto const offset = static_cast<std::size_t>(countr_one(e));
-            e |= static_cast<elem_t>(Bit << offset);
-            f(static_cast<IterArg>(idx + offset));
-        }
-    }
-};
-struct bit {
-    template <auto Bit, typename IterArg, auto Mask>
-    constexpr static auto fn(auto e, auto idx, auto &f) {
-        using elem_t = decltype(Bit);
-        for (auto i = std::size_t{}; i < popcount(Mask); ++i) {
-            bool b = e & static_cast<elem_t>(Bit << i);
-            f(static_cast<IterArg>(idx + i), b);
-        }
-    }
-};
-
 namespace detail {
-template <typename T>
-concept bit_spec = std::same_as<T, set_bit> or std::same_as<T, unset_bit> or
-                   std::same_as<T, bit>;
-}
+struct bitset_access;
+template <typename Op, typename L, typename R> class bitset_expr;
+template <typename B> class bitset_leaf;
+template <typename B> struct bitset_sequence;
+} // namespace detail
 
 template <auto Size,
           typename StorageElem = decltype(smallest_uint<to_underlying(Size)>())>
@@ -77,6 +50,24 @@ class bitset {
 
     std::array<elem_t, storage_size> storage{};
 
+    friend struct detail::bitset_access;
+    template <typename, typename, typename> friend class detail::bitset_expr;
+    template <typename> friend class detail::bitset_leaf;
+    template <typename> friend struct detail::bitset_sequence;
+
+    // word i (or at runtime, the block starting at word i) for expressions
+    template <typename V>
+    [[nodiscard]] constexpr auto get(std::size_t i) const -> V {
+#if STDX_SIMD_WIDTH != 0
+        if constexpr (not std::is_same_v<V, elem_t>) {
+            return detail::simd::load(std::data(storage) + i);
+        } else
+#endif
+        {
+            return storage[i];
+        }
+    }
+
     constexpr static auto lastmask = []() -> elem_t {
         if constexpr (N % storage_elem_size != 0) {
             return allbits >> (storage_elem_size - (N % storage_elem_size));
@@ -100,13 +91,12 @@ class bitset {
                                                    bitset const &rhs) -> bool {
         if constexpr (N == 0) {
             return true;
+        } else {
+            return detail::simd::equal(std::data(lhs.storage),
+                                       std::data(rhs.storage),
+                                       storage_size - 1) and
+                   lhs.highbits() == rhs.highbits();
         }
-        for (auto i = std::size_t{}; i < storage_size - 1; ++i) {
-            if (lhs.storage[i] != rhs.storage[i]) {
-                return false;
-            }
-        }
-        return lhs.highbits() == rhs.highbits();
     }
 
     friend constexpr auto operator|(bitset lhs, bitset const &rhs) -> bitset {
@@ -163,17 +153,13 @@ class bitset {
 
     template <typename T, typename F, typename R>
     constexpr auto transform_reduce(F &&f, R &&r, T init) const -> T {
-        std::size_t i = 0;
-        for (auto e : storage) {
-            while (e != 0) {
-                auto const offset = static_cast<std::size_t>(countr_zero(e));
-                e &= static_cast<elem_t>(~(bit << offset));
-                init =
-                    r(std::move(init), f(static_cast<iter_arg_t>(i + offset)));
-            }
-            i += std::numeric_limits<elem_t>::digits;
+        if constexpr (N == 0) {
+            return init;
+        } else {
+            return detail::bitset_words::transform_reduce<iter_arg_t>(
+                std::data(storage), storage_size, lastmask, f, r,
+                std::move(init));
         }
-        return init;
     }
 
     template <typename T, typename F, typename R, auto M, typename... S>
@@ -285,30 +271,9 @@ class bitset {
 
     constexpr auto set(lsb_t lsb, msb_t msb, bool value = true) LIFETIMEBOUND
         -> bitset & {
-        auto const l = to_underlying(lsb);
-        auto const m = to_underlying(msb);
-        auto [l_index, l_offset] = indices(l);
-        auto const [m_index, m_offset] = indices(m);
-
-        using setfn = auto (*)(elem_t *, elem_t)->void;
-        auto const fn = [&]() -> setfn {
-            if (value) {
-                return [](elem_t *ptr, elem_t val) { *ptr |= val; };
-            }
-            return [](elem_t *ptr, elem_t val) { *ptr &= ~val; };
-        }();
-
-        auto l_mask = std::numeric_limits<elem_t>::max() << l_offset;
-        if (l_index != m_index) {
-            fn(&storage[l_index++], static_cast<elem_t>(l_mask));
-            l_mask = std::numeric_limits<elem_t>::max();
-        }
-        while (l_index != m_index) {
-            fn(&storage[l_index++], static_cast<elem_t>(l_mask));
-        }
-        auto const m_mask = std::numeric_limits<elem_t>::max() >>
-                            (storage_elem_size - m_offset - 1);
-        fn(&storage[l_index], static_cast<elem_t>(l_mask & m_mask));
+        detail::bitset_words::set_range(std::data(storage),
+                                        to_underlying(lsb), to_underlying(msb),
+                                        value);
         return *this;
     }
 
@@ -368,21 +333,21 @@ class bitset {
     }
 
     constexpr auto flip() LIFETIMEBOUND -> bitset & {
-        for (auto &elem : storage) {
-            elem ^= allbits;
-        }
+        detail::simd::transform(std::data(storage), storage_size,
+                                std::bit_not{});
         return *this;
     }
 
     [[nodiscard]] constexpr auto count() const -> std::size_t {
         if constexpr (N == 0) {
             return {};
+        } else if constexpr (storage_size == 1) {
+            return static_cast<std::size_t>(popcount(highbits()));
+        } else {
+            return static_cast<std::size_t>(popcount(highbits())) +
+                   detail::simd::popcount(std::data(storage),
+                                          storage_size - 1);
         }
-        auto n = static_cast<std::size_t>(popcount(highbits()));
-        for (auto i = std::size_t{}; i < storage_size - 1; ++i) {
-            n += static_cast<std::size_t>(popcount(storage[i]));
-        }
-        return n;
     }
 
     [[nodiscard]] constexpr auto size() const -> std::size_t { return count(); }
@@ -401,96 +366,116 @@ class bitset {
     [[nodiscard]] constexpr auto none() const -> bool { return empty(); }
 
     [[nodiscard]] constexpr auto lowest_unset() const {
-        std::size_t i = 0;
-        for (auto e : storage) {
-            if (auto offset = static_cast<std::size_t>(countr_one(e));
-                offset != std::numeric_limits<elem_t>::digits) {
-                return static_cast<iter_arg_t>(i + offset);
-            }
-            i += std::numeric_limits<elem_t>::digits;
+        return detail::bitset_words::lowest_unset<iter_arg_t>(
+            std::data(storage), storage_size);
+    }
+
+    // Searches skip whole words. Each returns capacity() when there is no
+    // such bit.
+    template <detail::bit_spec Spec = set_bit>
+    [[nodiscard]] constexpr auto find_first() const -> std::size_t {
+        static_assert(not std::is_same_v<Spec, stdx::bit>,
+                      "Search for set_bit or unset_bit");
+        return detail::bitset_words::find_from<Spec>(
+            std::data(storage), storage_size, lastmask, N, 0);
+    }
+
+    template <detail::bit_spec Spec = set_bit>
+    [[nodiscard]] constexpr auto find_next(std::size_t pos) const
+        -> std::size_t {
+        static_assert(not std::is_same_v<Spec, stdx::bit>,
+                      "Search for set_bit or unset_bit");
+        if (pos >= N) {
+            return N;
         }
-        return static_cast<iter_arg_t>(i);
+        return detail::bitset_words::find_from<Spec>(
+            std::data(storage), storage_size, lastmask, N, pos + 1);
     }
 
-    [[nodiscard]] constexpr auto operator~() const -> bitset {
-        bitset result{};
-        for (auto i = std::size_t{}; i < storage_size; ++i) {
-            result.storage[i] = static_cast<elem_t>(~storage[i]);
+    template <detail::bit_spec Spec = set_bit>
+    [[nodiscard]] constexpr auto find_prev(std::size_t pos) const
+        -> std::size_t {
+        static_assert(not std::is_same_v<Spec, stdx::bit>,
+                      "Search for set_bit or unset_bit");
+        if (pos == 0) {
+            return N;
+        }
+        return detail::bitset_words::find_to<Spec>(
+            std::data(storage), storage_size, lastmask, N, pos - 1);
+    }
+
+    template <detail::bit_spec Spec = set_bit>
+    [[nodiscard]] constexpr auto find_last() const -> std::size_t {
+        static_assert(not std::is_same_v<Spec, stdx::bit>,
+                      "Search for set_bit or unset_bit");
+        return detail::bitset_words::find_to<Spec>(
+            std::data(storage), storage_size, lastmask, N, N);
+    }
+
+    // Bidirectional ranges of the set and unset bits. They refer to this
+    // bitset, which must outlive them.
+    [[nodiscard]] constexpr auto set_bits() const LIFETIMEBOUND {
+        return detail::bit_range<bitset, set_bit, iter_arg_t>{*this};
+    }
+    [[nodiscard]] constexpr auto unset_bits() const LIFETIMEBOUND {
+        return detail::bit_range<bitset, unset_bit, iter_arg_t>{*this};
+    }
+
+    // Writes the indices of set bits (from pos upwards) to out, stopping when
+    // out is full, and returns the number written. To decode in batches,
+    // resume from one past the last index written.
+    template <typename T, std::size_t Extent>
+    [[nodiscard]] constexpr auto decode_set_bits(span<T, Extent> out,
+                                                 std::size_t pos = 0) const
+        -> std::size_t {
+        static_assert(std::is_unsigned_v<T> and
+                          (N == 0 or N - 1 <= std::numeric_limits<T>::max()),
+                      "Index type must be unsigned and able to hold every "
+                      "bit index");
+        if constexpr (N == 0) {
+            return {};
+        } else {
+            return detail::bitset_words::decode(
+                std::data(storage), storage_size, lastmask, pos,
+                std::data(out), std::size(out));
         }
+    }
+
+    [[nodiscard]] constexpr auto operator~() const -> bitset {
+        bitset result{*this};
+        result.flip();
         return result;
     }
 
     constexpr auto operator|=(bitset const &rhs) LIFETIMEBOUND->bitset & {
-        for (auto i = std::size_t{}; i < storage_size; ++i) {
-            storage[i] |= rhs.storage[i];
-        }
+        detail::simd::transform(std::data(storage), std::data(rhs.storage),
+                                storage_size, std::bit_or{});
         return *this;
     }
     constexpr auto operator&=(bitset const &rhs) LIFETIMEBOUND->bitset & {
-        for (auto i = std::size_t{}; i < storage_size; ++i) {
-            storage[i] &= rhs.storage[i];
-        }
+        detail::simd::transform(std::data(storage), std::data(rhs.storage),
+                                storage_size, std::bit_and{});
         return *this;
     }
     constexpr auto operator^=(bitset const &rhs) LIFETIMEBOUND->bitset & {
-        for (auto i = std::size_t{}; i < storage_size; ++i) {
-            storage[i] ^= rhs.storage[i];
-        }
+        detail::simd::transform(std::data(storage), std::data(rhs.storage),
+                                storage_size, std::bit_xor{});
         return *this;
     }
 
     constexpr auto operator<<=(std::size_t pos) LIFETIMEBOUND->bitset & {
         if constexpr (N != 0) {
-            auto dst = storage_size - 1;
-            auto const start = dst - (pos / storage_elem_size);
-            pos %= storage_elem_size;
-
-            if (pos == 0) {
-                for (auto i = start; i > std::size_t{}; --i) {
-                    storage[dst] = storage[i];
-                    --dst;
-                }
-            } else {
-                auto const borrow_shift = storage_elem_size - pos;
-                for (auto i = start; i > std::size_t{}; --i) {
-                    storage[dst] = static_cast<elem_t>(storage[i] << pos);
-                    storage[dst] |=
-                        static_cast<elem_t>(storage[i - 1] >> borrow_shift);
-                    --dst;
-                }
-            }
-            storage[dst] = static_cast<elem_t>(storage.front() << pos);
-            while (dst > std::size_t{}) {
-                storage[--dst] = 0;
-            }
+            detail::bitset_words::shift_left(std::data(storage), storage_size,
+                                             pos);
         }
         return *this;
     }
 
     constexpr auto operator>>=(std::size_t pos) LIFETIMEBOUND->bitset & {
         if constexpr (N != 0) {
-            auto dst = std::size_t{};
-            auto const start = pos / storage_elem_size;
-            pos %= storage_elem_size;
-
-            if (pos == 0) {
-                for (auto i = start; i < storage_size - 1; ++i) {
-                    storage[dst] = storage[i];
-                    ++dst;
-                }
-            } else {
-                auto const borrow_shift = storage_elem_size - pos;
-                for (auto i = start; i < storage_size - 1; ++i) {
-                    storage[dst] = static_cast<elem_t>(storage[i] >> pos);
-                    storage[dst] |=
-                        static_cast<elem_t>(storage[i + 1] << borrow_shift);
-                    ++dst;
-                }
-            }
-            storage[dst++] = static_cast<elem_t>(storage.back() >> pos);
-            while (dst < storage_size) {
-                storage[dst++] = 0;
-            }
+            storage.back() &= lastmask;
+            detail::bitset_words::shift_right(std::data(storage), storage_size,
+                                              pos);
         }
         return *this;
     }
@@ -521,6 +506,323 @@ template <typename T, typename F, typename R, auto M, typename... S>
 
 template <std::size_t N> bitset(ct_string<N>) -> bitset<N - 1>;
 
+namespace detail {
+// the storage words of a bitset, for views and containers built on bitsets
+struct bitset_access {
+    template <auto Size, typename S>
+    [[nodiscard]] constexpr static auto words(bitset<Size, S> &bs) -> S * {
+        return std::data(bs.storage);
+    }
+    template <auto Size, typename S>
+    [[nodiscard]] constexpr static auto words(bitset<Size, S> const &bs)
+        -> S const * {
+        return std::data(bs.storage);
+    }
+};
+
+template <typename T> struct bitset_operand_traits {};
+
+template <auto Size, typename S>
+struct bitset_operand_traits<bitset<Size, S>> {
+    using bitset_t = bitset<Size, S>;
+    using elem_t = S;
+    constexpr static auto size = Size;
+    constexpr static auto lazy = false;
+};
+
+template <typename B>
+struct bitset_operand_traits<bitset_leaf<B>> : bitset_operand_traits<B> {
+    constexpr static auto lazy = true;
+};
+
+template <typename Op, typename L, typename R>
+struct bitset_operand_traits<bitset_expr<Op, L, R>>
+    : bitset_operand_traits<std::remove_cvref_t<L>> {
+    constexpr static auto lazy = true;
+};
+
+template <typename T>
+using operand_bitset_t =
+    typename bitset_operand_traits<std::remove_cvref_t<T>>::bitset_t;
+
+template <typename T>
+concept bitset_operand = requires { typename operand_bitset_t<T>; };
+
+template <typename L, typename R>
+concept compatible_bitset_operands =
+    bitset_operand<L> and bitset_operand<R> and
+    std::is_same_v<operand_bitset_t<L>, operand_bitset_t<R>>;
+
+// the operators on two bitsets are eager; with a lazy operand they build an
+// expression
+template <typename L, typename R>
+concept lazy_bitset_operands =
+    compatible_bitset_operands<L, R> and
+    (bitset_operand_traits<std::remove_cvref_t<L>>::lazy or
+     bitset_operand_traits<std::remove_cvref_t<R>>::lazy);
+
+// lvalue operands are held by reference, rvalues by value
+template <typename T>
+using operand_storage_t =
+    conditional_t<std::is_lvalue_reference_v<T>,
+                  std::remove_reference_t<T> const &, std::remove_cvref_t<T>>;
+
+struct bit_andnot {
+    template <typename T>
+    constexpr auto operator()(T const &lhs, T const &rhs) const {
+        return lhs & ~rhs;
+    }
+};
+
+// a bitset as the operand of a lazy expression: see stdx::lazy
+template <typename B> class bitset_leaf {
+    B const &bs;
+
+  public:
+    constexpr explicit bitset_leaf(B const &b) : bs{b} {}
+
+    template <typename V>
+    [[nodiscard]] constexpr auto get(std::size_t i) const -> V {
+        return bs.template get<V>(i);
+    }
+};
+
+// A lazy boolean combination of bitsets, started with stdx::lazy. Nothing is
+// computed until the expression is converted to a bitset or queried; then
+// every word is computed in one pass over the operands. An expression refers
+// to its lvalue operands, so it must not outlive them.
+template <typename Op, typename L, typename R> class bitset_expr {
+  public:
+    using bitset_t = operand_bitset_t<L>;
+
+  private:
+    using elem_t = typename bitset_t::elem_t;
+    using iter_arg_t = typename bitset_t::iter_arg_t;
+    constexpr static auto N = bitset_t::N;
+    constexpr static auto storage_size = bitset_t::storage_size;
+    constexpr static auto lastmask = bitset_t::lastmask;
+
+    L lhs;
+    R rhs;
+
+  public:
+    constexpr bitset_expr(L l, R r) : lhs(std::move(l)), rhs(std::move(r)) {}
+
+    template <typename V>
+    [[nodiscard]] constexpr auto get(std::size_t i) const -> V {
+        return static_cast<V>(
+            Op{}(lhs.template get<V>(i), rhs.template get<V>(i)));
+    }
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    [[nodiscard]] constexpr operator bitset_t() const {
+        bitset_t result{};
+        simd::generate(std::data(result.storage), storage_size, *this);
+        return result;
+    }
+
+    constexpr static std::integral_constant<std::size_t, N> capacity{};
+
+    template <typename T>
+    [[nodiscard]] constexpr auto operator[](T idx) const -> bool {
+        auto const pos = static_cast<std::size_t>(to_underlying(idx));
+        constexpr auto digits = std::size_t{bitset_t::storage_elem_size};
+        return ((get<elem_t>(pos / digits) >> (pos % digits)) & 1u) != 0;
+    }
+
+    [[nodiscard]] constexpr auto count() const -> std::size_t {
+        if constexpr (N == 0) {
+            return {};
+        } else {
+            return static_cast<std::size_t>(popcount(static_cast<elem_t>(
+                       get<elem_t>(storage_size - 1) & lastmask))) +
+                   simd::generated_popcount<elem_t>(*this, storage_size - 1);
+        }
+    }
+
+    [[nodiscard]] constexpr auto any() const -> bool {
+        if constexpr (N == 0) {
+            return false;
+        } else {
+            return (get<elem_t>(storage_size - 1) & lastmask) != 0 or
+                   simd::generated_any<elem_t>(*this, storage_size - 1);
+        }
+    }
+
+    [[nodiscard]] constexpr auto none() const -> bool { return not any(); }
+
+    [[nodiscard]] constexpr auto all() const -> bool {
+        return count() == capacity();
+    }
+
+    template <bit_spec Spec, typename F>
+    constexpr auto for_each(F &&f) const -> F {
+        if constexpr (N != 0) {
+            std::size_t idx = 0;
+            for (auto i = std::size_t{}; i < storage_size - 1; ++i) {
+                Spec::template fn<bitset_t::bit, iter_arg_t,
+                                  bitset_t::allbits>(get<elem_t>(i), idx, f);
+                idx += bitset_t::storage_elem_size;
+            }
+            Spec::template fn<bitset_t::bit, iter_arg_t, lastmask>(
+                static_cast<elem_t>(get<elem_t>(storage_size - 1) & lastmask),
+                idx, f);
+        }
+        return std::forward<F>(f);
+    }
+
+    [[nodiscard]] constexpr auto operator~() const -> bitset_t {
+        return ~static_cast<bitset_t>(*this);
+    }
+};
+
+template <typename Op, typename L, typename R>
+[[nodiscard]] constexpr auto make_bitset_expr(L &&lhs, R &&rhs) {
+    return bitset_expr<Op, operand_storage_t<L>, operand_storage_t<R>>{
+        std::forward<L>(lhs), std::forward<R>(rhs)};
+}
+} // namespace detail
+
+template <typename L, typename R>
+    requires detail::lazy_bitset_operands<L, R>
+[[nodiscard]] constexpr auto operator|(L &&lhs, R &&rhs) {
+    return detail::make_bitset_expr<std::bit_or<>>(std::forward<L>(lhs),
+                                                   std::forward<R>(rhs));
+}
+
+template <typename L, typename R>
+    requires detail::lazy_bitset_operands<L, R>
+[[nodiscard]] constexpr auto operator&(L &&lhs, R &&rhs) {
+    return detail::make_bitset_expr<std::bit_and<>>(std::forward<L>(lhs),
+                                                    std::forward<R>(rhs));
+}
+
+template <typename L, typename R>
+    requires detail::lazy_bitset_operands<L, R>
+[[nodiscard]] constexpr auto operator^(L &&lhs, R &&rhs) {
+    return detail::make_bitset_expr<std::bit_xor<>>(std::forward<L>(lhs),
+                                                    std::forward<R>(rhs));
+}
+
+template <typename L, typename R>
+    requires detail::lazy_bitset_operands<L, R>
+[[nodiscard]] constexpr auto operator-(L &&lhs, R &&rhs) {
+    return detail::make_bitset_expr<detail::bit_andnot>(std::forward<L>(lhs),
+                                                        std::forward<R>(rhs));
+}
+
+// Starts a lazy expression: stdx::lazy(a) & b (and any expression built from
+// it) is evaluated in one pass when it is converted to a bitset or queried.
+// The expression refers to its lvalue operands, so it must not outlive them.
+template <auto Size, typename S>
+[[nodiscard]] constexpr auto lazy(bitset<Size, S> const &bs LIFETIMEBOUND)
+    -> detail::bitset_leaf<bitset<Size, S>> {
+    return detail::bitset_leaf<bitset<Size, S>>{bs};
+}
+template <auto Size, typename S>
+auto lazy(bitset<Size, S> const &&) -> detail::bitset_leaf<bitset<Size, S>> =
+    delete;
+
+template <typename Op, typename L, typename R>
+bitset(detail::bitset_expr<Op, L, R>)
+    -> bitset<detail::bitset_operand_traits<std::remove_cvref_t<L>>::size,
+              typename detail::bitset_operand_traits<
+                  std::remove_cvref_t<L>>::elem_t>;
+
+template <typename Op, typename L, typename R, typename B>
+    requires std::is_same_v<B, detail::operand_bitset_t<L>>
+[[nodiscard]] constexpr auto operator==(detail::bitset_expr<Op, L, R> const &e,
+                                        B const &bs) -> bool {
+    return static_cast<B>(e) == bs;
+}
+
+template <detail::bit_spec Spec = set_bit, typename F, typename Op,
+          typename L, typename R>
+constexpr auto for_each(F &&f, detail::bitset_expr<Op, L, R> const &e) -> F {
+    return e.template for_each<Spec>(std::forward<F>(f));
+}
+
+template <typename T, typename F, typename R, typename Op, typename L,
+          typename Rhs>
+[[nodiscard]] constexpr auto
+transform_reduce(F &&f, R &&r, T init,
+                 detail::bitset_expr<Op, L, Rhs> const &e) -> T {
+    e.template for_each<set_bit>([&](auto i) {
+        init = r(std::move(init), f(i));
+    });
+    return init;
+}
+
+// Counts of combinations of two bitsets, computed without making the
+// combination
+template <typename L, typename R>
+    requires detail::compatible_bitset_operands<L, R>
+[[nodiscard]] constexpr auto intersection_count(L const &lhs, R const &rhs)
+    -> std::size_t {
+    return detail::make_bitset_expr<std::bit_and<>>(lhs, rhs).count();
+}
+
+template <typename L, typename R>
+    requires detail::compatible_bitset_operands<L, R>
+[[nodiscard]] constexpr auto union_count(L const &lhs, R const &rhs)
+    -> std::size_t {
+    return detail::make_bitset_expr<std::bit_or<>>(lhs, rhs).count();
+}
+
+template <typename L, typename R>
+    requires detail::compatible_bitset_operands<L, R>
+[[nodiscard]] constexpr auto difference_count(L const &lhs, R const &rhs)
+    -> std::size_t {
+    return detail::make_bitset_expr<detail::bit_andnot>(lhs, rhs).count();
+}
+
+namespace detail {
+// the words of an array of bitsets without unused bits, end to end
+template <typename B> struct bitset_sequence {
+    using elem_t = typename B::elem_t;
+    constexpr static auto storage_size = B::storage_size;
+    constexpr static auto contiguous =
+        B::lastmask == B::allbits and
+        sizeof(B) == storage_size * sizeof(elem_t);
+
+    B const *p;
+
+    template <typename V>
+    [[nodiscard]] constexpr auto get(std::size_t i) const -> V {
+        if constexpr (std::is_same_v<V, elem_t>) {
+            return p[i / storage_size].storage[i % storage_size];
+        } else {
+            static_assert(contiguous);
+            V v;
+            std::memcpy(&v,
+                        reinterpret_cast<unsigned char const *>(p) +
+                            i * sizeof(elem_t),
+                        sizeof(V));
+            return v;
+        }
+    }
+};
+} // namespace detail
+
+// The total count of a span of bitsets. When the bitset size is a multiple of
+// the storage element size, this is one Harley-Seal pass over all the words.
+template <typename B, std::size_t Extent>
+    requires std::is_same_v<std::remove_const_t<B>,
+                            detail::operand_bitset_t<B>>
+[[nodiscard]] constexpr auto total_count(span<B, Extent> bss) -> std::size_t {
+    using seq_t = detail::bitset_sequence<std::remove_const_t<B>>;
+    if constexpr (seq_t::contiguous and seq_t::storage_size != 0) {
+        return detail::simd::generated_popcount<typename seq_t::elem_t>(
+            seq_t{std::data(bss)}, std::size(bss) * seq_t::storage_size);
+    } else {
+        auto count = std::size_t{};
+        for (auto const &bs : bss) {
+            count += bs.count();
+        }
+        return count;
+    }
+}
+
 namespace detail {
 template <typename...> constexpr std::size_t index_of = 0;
 
@@ -530,6 +832,67 @@ constexpr std::size_t index_of<T, type_list<Us...>> =
 
 template <typename T>
 concept type_index_like = requires { typename T::type; };
+
+// Calls f.template operator()<I>() for a runtime index i < N through nested
+// switch statements of 16 cases each, so that each level compiles to a jump
+// table and the calls can be inlined into the cases. Stride is the number of
+// indices covered by each case at this level.
+constexpr inline auto switch_width = std::size_t{16};
+
+template <std::size_t N> constexpr auto top_switch_stride() -> std::size_t {
+    auto stride = std::size_t{1};
+    while (stride * switch_width < N) {
+        stride *= switch_width;
+    }
+    return stride;
+}
+
+template <std::size_t N, std::size_t Base = 0,
+          std::size_t Stride = top_switch_stride<N>(), typename F>
+constexpr auto index_switch(std::size_t i, F &f) -> void {
+    auto const visit = [&]<std::size_t K>() {
+        constexpr auto idx = Base + K * Stride;
+        if constexpr (idx < N) {
+            if constexpr (Stride == 1) {
+                f.template operator()<idx>();
+            } else {
+                index_switch<N, idx, Stride / switch_width>(i, f);
+            }
+        }
+    };
+    switch ((i - Base) / Stride) {
+    case 0x0: return visit.template operator()<0x0>();
+    case 0x1: return visit.template operator()<0x1>();
+    case 0x2: return visit.template operator()<0x2>();
+    case 0x3: return visit.template operator()<0x3>();
+    case 0x4: return visit.template operator()<0x4>();
+    case 0x5: return visit.template operator()<0x5>();
+    case 0x6: return visit.template operator()<0x6>();
+    case 0x7: return visit.template operator()<0x7>();
+    case 0x8: return visit.template operator()<0x8>();
+    case 0x9: return visit.template operator()<0x9>();
+    case 0xa: return visit.template operator()<0xa>();
+    case 0xb: return visit.template operator()<0xb>();
+    case 0xc: return visit.template operator()<0xc>();
+    case 0xd: return visit.template operator()<0xd>();
+    case 0xe: return visit.template operator()<0xe>();
+    case 0xf: return visit.template operator()<0xf>();
+    default: return;
+    }
+}
+} // namespace detail
+
+// How type_bitset::for_each gets from a bit index to the call for its type.
+// table_dispatch makes an indirect call through a table of function pointers;
+// switch_dispatch generates (nested) switch statements, whose cases call the
+// function directly and so may inline it.
+struct table_dispatch {};
+struct switch_dispatch {};
+
+namespace detail {
+template <typename T>
+concept type_dispatch =
+    std::same_as<T, table_dispatch> or std::same_as<T, switch_dispatch>;
 } // namespace detail
 
 template <typename... Ts> class type_bitset {
@@ -687,10 +1050,20 @@ template <typename... Ts> class type_bitset {
         return *this;
     }
 
-    template <detail::bit_spec Spec = set_bit, typename F>
+    template <detail::bit_spec Spec = set_bit,
+              detail::type_dispatch Dispatch = table_dispatch, typename F>
     constexpr auto for_each(F &&f) const -> F {
-        constexpr auto callers = make_callers<F>(std::make_index_sequence<N>{});
-        stdx::for_each<Spec>([&](auto i) { callers[i](f); }, bs);
+        if constexpr (std::is_same_v<Dispatch, switch_dispatch>) {
+            auto call = [&]<std::size_t I>() {
+                f.template operator()<boost::mp11::mp_at_c<list_t, I>, I>();
+            };
+            stdx::for_each<Spec>(
+                [&](auto i) { detail::index_switch<N>(i, call); }, bs);
+        } else {
+            constexpr auto callers =
+                make_callers<F>(std::make_index_sequence<N>{});
+            stdx::for_each<Spec>([&](auto i) { callers[i](f); }, bs);
+        }
         return f;
     }
 };
@@ -0,0 +1,425 @@
+#pragma once
+
+#include <stdx/bit.hpp>
+#include <stdx/bitset.hpp>
+#include <stdx/compiler.hpp>
+#include <stdx/detail/bitset_common.hpp>
+#include <stdx/detail/simd.hpp>
+#include <stdx/span.hpp>
+#include <stdx/type_traits.hpp>
+#include <stdx/udls.hpp>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace stdx {
+inline namespace v1 {
+// A non-owning view of Size bits in existing storage words. With a const
+// StorageElem the view is read-only. Bits above Size in the last word belong
+// to the owner of the storage: they are ignored and never modified.
+template <auto Size, typename StorageElem> class bitset_ref {
+    constexpr static std::size_t N = to_underlying(Size);
+    using elem_t = std::remove_const_t<StorageElem>;
+    static_assert(std::is_unsigned_v<elem_t>,
+                  "Storage element for bitset_ref must be an unsigned type");
+    static_assert(N > 0, "bitset_ref must refer to at least one bit");
+
+    constexpr static auto is_mutable = not std::is_const_v<StorageElem>;
+    constexpr static auto storage_elem_size =
+        std::size_t{std::numeric_limits<elem_t>::digits};
+    constexpr static auto storage_size =
+        (N + storage_elem_size - 1) / storage_elem_size;
+    constexpr static auto bit = elem_t{1U};
+    constexpr static auto allbits = std::numeric_limits<elem_t>::max();
+
+    constexpr static auto lastmask = []() -> elem_t {
+        if constexpr (N % storage_elem_size != 0) {
+            return allbits >> (storage_elem_size - (N % storage_elem_size));
+        } else {
+            return allbits;
+        }
+    }();
+
+    StorageElem *storage;
+
+    template <auto, typename> friend class bitset_ref;
+
+    using const_ref = bitset_ref<Size, elem_t const>;
+    using bitset_t = bitset<Size, elem_t>;
+
+    using iter_arg_t = conditional_t<std::is_enum_v<decltype(Size)>,
+                                     decltype(Size), std::size_t>;
+
+    template <typename T> consteval static auto admissible_enum() {
+        return not std::is_enum_v<T> or std::is_same_v<T, decltype(Size)>;
+    }
+
+    [[nodiscard]] constexpr auto highbits() const -> elem_t {
+        return static_cast<elem_t>(storage[storage_size - 1] & lastmask);
+    }
+
+    [[nodiscard]] constexpr static auto indices(std::size_t pos) {
+        struct locator {
+            std::size_t index;
+            std::size_t offset;
+        };
+        return locator{pos / storage_elem_size, pos % storage_elem_size};
+    }
+
+    // apply a whole-word operation, keeping the bits above Size as they were
+    template <typename F>
+    constexpr auto preserving_high_bits(F &&f) const -> void {
+        static_assert(is_mutable, "Cannot modify through a const bitset_ref");
+        if constexpr (lastmask == allbits) {
+            f();
+        } else {
+            auto &last = storage[storage_size - 1];
+            auto const high = static_cast<elem_t>(last & ~lastmask);
+            f();
+            last = static_cast<elem_t>((last & lastmask) | high);
+        }
+    }
+
+    template <typename Op>
+    constexpr auto apply(const_ref rhs, Op op) const -> bitset_ref const & {
+        preserving_high_bits([&] {
+            detail::simd::transform(storage, rhs.storage, storage_size, op);
+        });
+        return *this;
+    }
+
+  public:
+    constexpr explicit bitset_ref(StorageElem *p) : storage{p} {}
+
+    template <std::size_t Extent>
+    constexpr explicit bitset_ref(span<StorageElem, Extent> s)
+        : storage{std::data(s)} {
+        static_assert(Extent == dynamic_extent or Extent >= storage_size,
+                      "span is too small for bitset_ref");
+    }
+
+    template <std::size_t M>
+    constexpr explicit bitset_ref(StorageElem (&arr)[M]) : storage{arr} {
+        static_assert(M >= storage_size, "array is too small for bitset_ref");
+    }
+
+    template <std::size_t M>
+    constexpr explicit bitset_ref(std::array<elem_t, M> &arr)
+        : storage{std::data(arr)} {
+        static_assert(M >= storage_size, "array is too small for bitset_ref");
+    }
+
+    template <std::size_t M>
+    constexpr explicit bitset_ref(std::array<elem_t, M> const &arr)
+        : storage{std::data(arr)} {
+        static_assert(not is_mutable, "A const array needs a const bitset_ref");
+        static_assert(M >= storage_size, "array is too small for bitset_ref");
+    }
+
+    constexpr explicit(false) bitset_ref(bitset_t &bs LIFETIMEBOUND)
+        : storage{detail::bitset_access::words(bs)} {}
+
+    constexpr explicit(false) bitset_ref(bitset_t const &bs LIFETIMEBOUND)
+        : storage{detail::bitset_access::words(bs)} {
+        static_assert(not is_mutable,
+                      "A const bitset needs a const bitset_ref");
+    }
+
+    // a mutable view converts to a const view
+    template <typename E>
+        requires(std::is_same_v<E const, StorageElem> and
+                 not std::is_same_v<E, StorageElem>)
+    constexpr explicit(false) bitset_ref(bitset_ref<Size, E> const &r)
+        : storage{r.storage} {}
+
+    [[nodiscard]] constexpr auto data() const -> StorageElem * {
+        return storage;
+    }
+
+    [[nodiscard]] constexpr auto to_bitset() const -> bitset_t {
+        auto bs = bitset_t{};
+        auto *words = detail::bitset_access::words(bs);
+        for (auto i = std::size_t{}; i < storage_size; ++i) {
+            words[i] = storage[i];
+        }
+        words[storage_size - 1] &= lastmask;
+        return bs;
+    }
+
+    constexpr static std::integral_constant<std::size_t, N> capacity{};
+
+    template <typename T>
+    [[nodiscard]] constexpr auto operator[](T idx) const -> bool {
+        static_assert(admissible_enum<T>() or
+                          stdx::always_false_v<T, decltype(Size)>,
+                      "T is not the required enumeration type");
+        auto const pos = static_cast<std::size_t>(to_underlying(idx));
+        auto const [index, offset] = indices(pos);
+        return (storage[index] & (bit << offset)) != 0;
+    }
+
+    template <typename T>
+    constexpr auto set(T idx, bool value = true) const LIFETIMEBOUND
+        -> bitset_ref const & {
+        static_assert(is_mutable, "Cannot modify through a const bitset_ref");
+        static_assert(admissible_enum<T>() or
+                          stdx::always_false_v<T, decltype(Size)>,
+                      "T is not the required enumeration type");
+        auto const pos = static_cast<std::size_t>(to_underlying(idx));
+        auto const [index, offset] = indices(pos);
+        if (value) {
+            storage[index] |= static_cast<elem_t>(bit << offset);
+        } else {
+            storage[index] &= static_cast<elem_t>(~(bit << offset));
+        }
+        return *this;
+    }
+
+    constexpr auto set(lsb_t lsb, msb_t msb, bool value = true) const
+        LIFETIMEBOUND -> bitset_ref const & {
+        static_assert(is_mutable, "Cannot modify through a const bitset_ref");
+        detail::bitset_words::set_range(storage, to_underlying(lsb),
+                                        to_underlying(msb), value);
+        return *this;
+    }
+
+    constexpr auto set(lsb_t lsb, length_t len, bool value = true) const
+        LIFETIMEBOUND -> bitset_ref const & {
+        auto const l = to_underlying(lsb);
+        auto const length = to_underlying(len);
+        return set(lsb, static_cast<msb_t>(l + length - 1), value);
+    }
+
+    constexpr auto set() const LIFETIMEBOUND -> bitset_ref const & {
+        return set(lsb_t{}, static_cast<msb_t>(N - 1));
+    }
+
+    template <typename T>
+    constexpr auto reset(T idx) const LIFETIMEBOUND -> bitset_ref const & {
+        return set(idx, false);
+    }
+
+    constexpr auto reset() const LIFETIMEBOUND -> bitset_ref const & {
+        return set(lsb_t{}, static_cast<msb_t>(N - 1), false);
+    }
+
+    constexpr auto reset(lsb_t lsb, msb_t msb) const LIFETIMEBOUND
+        -> bitset_ref const & {
+        return set(lsb, msb, false);
+    }
+
+    constexpr auto reset(lsb_t lsb, length_t len) const LIFETIMEBOUND
+        -> bitset_ref const & {
+        return set(lsb, len, false);
+    }
+
+    template <typename... Ts>
+    constexpr auto clear(Ts... ts) const LIFETIMEBOUND -> bitset_ref const & {
+        return reset(ts...);
+    }
+
+    template <typename T>
+    constexpr auto flip(T idx) const LIFETIMEBOUND -> bitset_ref const & {
+        static_assert(is_mutable, "Cannot modify through a const bitset_ref");
+        static_assert(admissible_enum<T>() or
+                          stdx::always_false_v<T, decltype(Size)>,
+                      "T is not the required enumeration type");
+        auto const pos = static_cast<std::size_t>(to_underlying(idx));
+        auto const [index, offset] = indices(pos);
+        storage[index] ^= static_cast<elem_t>(bit << offset);
+        return *this;
+    }
+
+    constexpr auto flip() const LIFETIMEBOUND -> bitset_ref const & {
+        preserving_high_bits([&] {
+            detail::simd::transform(storage, storage_size, std::bit_not{});
+        });
+        return *this;
+    }
+
+    [[nodiscard]] constexpr auto count() const -> std::size_t {
+        return static_cast<std::size_t>(popcount(highbits())) +
+               detail::simd::popcount(storage, storage_size - 1);
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t { return count(); }
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        return find_first() == N;
+    }
+    [[nodiscard]] constexpr auto all() const -> bool {
+        return find_first<unset_bit>() == N;
+    }
+    [[nodiscard]] constexpr auto any() const -> bool { return not empty(); }
+    [[nodiscard]] constexpr auto none() const -> bool { return empty(); }
+
+    [[nodiscard]] constexpr auto lowest_unset() const -> iter_arg_t {
+        return static_cast<iter_arg_t>(find_first<unset_bit>());
+    }
+
+    template <detail::bit_spec Spec = set_bit>
+    [[nodiscard]] constexpr auto find_first() const -> std::size_t {
+        return detail::bitset_words::find_from<Spec>(storage, storage_size,
+                                                     lastmask, N, 0);
+    }
+
+    template <detail::bit_spec Spec = set_bit>
+    [[nodiscard]] constexpr auto find_next(std::size_t pos) const
+        -> std::size_t {
+        if (pos >= N) {
+            return N;
+        }
+        return detail::bitset_words::find_from<Spec>(storage, storage_size,
+                                                     lastmask, N, pos + 1);
+    }
+
+    template <detail::bit_spec Spec = set_bit>
+    [[nodiscard]] constexpr auto find_prev(std::size_t pos) const
+        -> std::size_t {
+        if (pos == 0) {
+            return N;
+        }
+        return detail::bitset_words::find_to<Spec>(storage, storage_size,
+                                                   lastmask, N, pos - 1);
+    }
+
+    template <detail::bit_spec Spec = set_bit>
+    [[nodiscard]] constexpr auto find_last() const -> std::size_t {
+        return detail::bitset_words::find_to<Spec>(storage, storage_size,
+                                                   lastmask, N, N);
+    }
+
+    [[nodiscard]] constexpr auto set_bits() const {
+        return detail::bit_range<bitset_ref, set_bit, iter_arg_t>{*this};
+    }
+    [[nodiscard]] constexpr auto unset_bits() const {
+        return detail::bit_range<bitset_ref, unset_bit, iter_arg_t>{*this};
+    }
+
+    template <typename T, std::size_t Extent>
+    [[nodiscard]] constexpr auto decode_set_bits(span<T, Extent> out,
+                                                 std::size_t pos = 0) const
+        -> std::size_t {
+        static_assert(std::is_unsigned_v<T> and
+                          N - 1 <= std::numeric_limits<T>::max(),
+                      "Index type must be unsigned and able to hold every "
+                      "bit index");
+        return detail::bitset_words::decode(storage, storage_size, lastmask,
+                                            pos, std::data(out),
+                                            std::size(out));
+    }
+
+    template <detail::bit_spec Spec = set_bit, typename F>
+    constexpr auto for_each(F &&f) const -> F {
+        std::size_t idx = 0;
+        for (auto i = std::size_t{}; i < storage_size - 1; ++i) {
+            Spec::template fn<bit, iter_arg_t, allbits>(storage[i], idx, f);
+            idx += storage_elem_size;
+        }
+        Spec::template fn<bit, iter_arg_t, lastmask>(highbits(), idx, f);
+        return std::forward<F>(f);
+    }
+
+    template <typename T, typename F, typename R>
+    constexpr auto transform_reduce(F &&f, R &&r, T init) const -> T {
+        return detail::bitset_words::transform_reduce<iter_arg_t>(
+            static_cast<elem_t const *>(storage), storage_size, lastmask, f,
+            r, std::move(init));
+    }
+
+    constexpr auto operator|=(const_ref rhs) const LIFETIMEBOUND
+        -> bitset_ref const & {
+        return apply(rhs, std::bit_or{});
+    }
+    constexpr auto operator&=(const_ref rhs) const LIFETIMEBOUND
+        -> bitset_ref const & {
+        return apply(rhs, std::bit_and{});
+    }
+    constexpr auto operator^=(const_ref rhs) const LIFETIMEBOUND
+        -> bitset_ref const & {
+        return apply(rhs, std::bit_xor{});
+    }
+    constexpr auto operator-=(const_ref rhs) const LIFETIMEBOUND
+        -> bitset_ref const & {
+        return apply(rhs, [](auto x, auto y) { return x & ~y; });
+    }
+
+    constexpr auto operator<<=(std::size_t pos) const LIFETIMEBOUND
+        -> bitset_ref const & {
+        preserving_high_bits([&] {
+            detail::bitset_words::shift_left(storage, storage_size, pos);
+        });
+        return *this;
+    }
+
+    constexpr auto operator>>=(std::size_t pos) const LIFETIMEBOUND
+        -> bitset_ref const & {
+        preserving_high_bits([&] {
+            storage[storage_size - 1] &= lastmask;
+            detail::bitset_words::shift_right(storage, storage_size, pos);
+        });
+        return *this;
+    }
+
+    [[nodiscard]] constexpr auto operator~() const -> bitset_t {
+        return ~to_bitset();
+    }
+
+    [[nodiscard]] friend constexpr auto operator|(bitset_ref const &lhs,
+                                                  const_ref rhs) -> bitset_t {
+        auto r = lhs.to_bitset();
+        bitset_ref<Size, elem_t>{r} |= rhs;
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto operator&(bitset_ref const &lhs,
+                                                  const_ref rhs) -> bitset_t {
+        auto r = lhs.to_bitset();
+        bitset_ref<Size, elem_t>{r} &= rhs;
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto operator^(bitset_ref const &lhs,
+                                                  const_ref rhs) -> bitset_t {
+        auto r = lhs.to_bitset();
+        bitset_ref<Size, elem_t>{r} ^= rhs;
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto operator-(bitset_ref const &lhs,
+                                                  const_ref rhs) -> bitset_t {
+        auto r = lhs.to_bitset();
+        bitset_ref<Size, elem_t>{r} -= rhs;
+        return r;
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(bitset_ref const &lhs,
+                                                   const_ref rhs) -> bool {
+        return detail::simd::equal(static_cast<elem_t const *>(lhs.storage),
+                                   rhs.storage, storage_size - 1) and
+               lhs.highbits() == rhs.highbits();
+    }
+};
+
+template <auto Size, typename S>
+bitset_ref(bitset<Size, S> &) -> bitset_ref<Size, S>;
+template <auto Size, typename S>
+bitset_ref(bitset<Size, S> const &) -> bitset_ref<Size, S const>;
+
+template <detail::bit_spec Spec = set_bit, typename F, auto M, typename S>
+constexpr auto for_each(F &&f, bitset_ref<M, S> const &bs) -> F {
+    return bs.template for_each<Spec>(std::forward<F>(f));
+}
+
+template <typename T, typename F, typename R, auto M, typename S>
+[[nodiscard]] constexpr auto transform_reduce(F &&f, R &&r, T init,
+                                              bitset_ref<M, S> const &bs)
+    -> T {
+    return bs.transform_reduce(std::forward<F>(f), std::forward<R>(r),
+                               std::move(init));
+}
+} // namespace v1
+} // namespace stdx
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <stdx/bitset.hpp>
+#include <stdx/compiler.hpp>
+#include <stdx/hash.hpp>
+#include <stdx/span.hpp>
+#include <stdx/type_traits.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace stdx {
+inline namespace v1 {
+// The default hash for bloom filters
+using bloom_hash = cx_hash;
+
+namespace detail::bloom {
+// Each key maps to one cache-line block of 512 bits, and all its probes fall
+// in that block.
+constexpr inline auto block_bits = std::size_t{512};
+constexpr inline auto block_words = block_bits / 64;
+
+struct probe {
+    std::size_t first_word;
+    std::array<std::uint64_t, block_words> masks;
+};
+
+template <std::size_t NumBlocks, std::size_t Hashes>
+[[nodiscard]] constexpr auto make_probe(std::uint64_t h) -> probe {
+    auto p = probe{((h >> 32u) * NumBlocks >> 32u) * block_words, {}};
+    // double hashing with an odd step gives Hashes distinct positions
+    auto const g = bloom_hash::mix(h + 0x9e37'79b9'7f4a'7c15u);
+    auto const h1 = static_cast<std::uint32_t>(g);
+    auto const h2 = static_cast<std::uint32_t>(g >> 32u) | 1u;
+    for (auto i = std::uint32_t{}; i < Hashes; ++i) {
+        auto const pos = (h1 + i * h2) % block_bits;
+        p.masks[pos / 64] |= std::uint64_t{1} << (pos % 64);
+    }
+    return p;
+}
+
+[[nodiscard]] constexpr auto matches(std::uint64_t const *words,
+                                     probe const &p) -> bool {
+    auto missing = std::uint64_t{};
+    for (auto w = std::size_t{}; w < block_words; ++w) {
+        missing |= p.masks[w] & ~words[p.first_word + w];
+    }
+    return missing == 0;
+}
+
+constexpr auto prefetch([[maybe_unused]] void const *p) -> void {
+    if (not std::is_constant_evaluated()) {
+        __builtin_prefetch(p);
+    }
+}
+
+// batches compute the probes for a group of keys and prefetch their blocks
+// before touching any of them
+constexpr inline auto batch_size = std::size_t{8};
+} // namespace detail::bloom
+
+// A blocked Bloom filter of Bits bits (a multiple of 512) using Hashes probes
+// per key. A key's probes all fall in one 64-byte block, so each insert or
+// query touches one cache line.
+template <std::size_t Bits, std::size_t Hashes, typename Hash = bloom_hash>
+class bloom_filter {
+    static_assert(Bits > 0 and Bits % detail::bloom::block_bits == 0,
+                  "Bloom filter size must be a multiple of 512 bits");
+    static_assert(Hashes > 0 and Hashes <= detail::bloom::block_bits,
+                  "Bloom filter must use between 1 and 512 hashes");
+
+    constexpr static auto num_blocks = Bits / detail::bloom::block_bits;
+
+    bitset<Bits, std::uint64_t> storage{};
+    [[no_unique_address]] Hash hash{};
+
+    template <typename K>
+    [[nodiscard]] constexpr auto probe_for(K const &key) const {
+        return detail::bloom::make_probe<num_blocks, Hashes>(hash(key));
+    }
+
+    constexpr auto apply(detail::bloom::probe const &p) -> void {
+        auto *words = detail::bitset_access::words(storage);
+        for (auto w = std::size_t{}; w < detail::bloom::block_words; ++w) {
+            words[p.first_word + w] |= p.masks[w];
+        }
+    }
+
+    [[nodiscard]] constexpr auto test(detail::bloom::probe const &p) const
+        -> bool {
+        return detail::bloom::matches(detail::bitset_access::words(storage), p);
+    }
+
+    template <typename K, std::size_t Extent, typename F>
+    constexpr auto for_each_probe(span<K, Extent> keys, F &&f) const -> void {
+        auto const *words = detail::bitset_access::words(storage);
+        std::array<detail::bloom::probe, detail::bloom::batch_size> probes{};
+        for (auto i = std::size_t{}; i < std::size(keys);
+             i += detail::bloom::batch_size) {
+            auto const n =
+                std::min(detail::bloom::batch_size, std::size(keys) - i);
+            for (auto j = std::size_t{}; j < n; ++j) {
+                probes[j] = probe_for(keys[i + j]);
+                detail::bloom::prefetch(words + probes[j].first_word);
+            }
+            for (auto j = std::size_t{}; j < n; ++j) {
+                f(i + j, probes[j]);
+            }
+        }
+    }
+
+  public:
+    constexpr bloom_filter() = default;
+    constexpr explicit bloom_filter(Hash h) : hash{std::move(h)} {}
+
+    template <typename K, std::size_t Extent>
+    constexpr explicit bloom_filter(span<K, Extent> keys, Hash h = {})
+        : hash{std::move(h)} {
+        insert(keys);
+    }
+
+    constexpr static std::integral_constant<std::size_t, Bits> capacity{};
+    constexpr static std::integral_constant<std::size_t, Hashes> hashes{};
+
+    template <typename K> constexpr auto insert(K const &key) -> void {
+        apply(probe_for(key));
+    }
+
+    template <typename K, std::size_t Extent>
+    constexpr auto insert(span<K, Extent> keys) -> void {
+        for_each_probe(keys, [&](auto, auto const &p) { apply(p); });
+    }
+
+    template <typename K>
+    [[nodiscard]] constexpr auto may_contain(K const &key) const -> bool {
+        return test(probe_for(key));
+    }
+
+    // Writes whether each key may be present to out (which must be at least
+    // as large as keys) and returns the number that may be present.
+    template <typename K, std::size_t Extent, std::size_t OutExtent>
+    constexpr auto may_contain(span<K, Extent> keys,
+                               span<bool, OutExtent> out) const
+        -> std::size_t {
+        auto n = std::size_t{};
+        for_each_probe(keys, [&](auto i, auto const &p) {
+            out[i] = test(p);
+            n += out[i] ? 1u : 0u;
+        });
+        return n;
+    }
+
+    constexpr auto clear() -> void { storage.reset(); }
+
+    [[nodiscard]] constexpr auto bits() const LIFETIMEBOUND
+        -> bitset<Bits, std::uint64_t> const & {
+        return storage;
+    }
+};
+} // namespace v1
+} // namespace stdx
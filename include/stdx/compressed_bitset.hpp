@@ -0,0 +1,677 @@
+#pragma once
+
+#include <stdx/bit.hpp>
+#include <stdx/compiler.hpp>
+#include <stdx/detail/bitset_common.hpp>
+#include <stdx/detail/simd.hpp>
+#include <stdx/udls.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stdx {
+inline namespace v1 {
+namespace detail::compressed {
+constexpr inline auto chunk_bits = std::size_t{1} << 16u;
+constexpr inline auto bitmap_words = chunk_bits / 64u;
+// above this cardinality, a bitmap is no larger than a sorted array
+constexpr inline auto array_max = std::size_t{4096};
+// Erasing from a bitmap converts it back to an array only at this lower
+// cardinality, so that alternately inserting and erasing around array_max
+// does not convert (and reallocate) each time.
+constexpr inline auto bitmap_min = array_max - 512;
+
+enum struct kind : std::uint8_t { array, bitmap, run };
+
+// The members of one 2^16-value chunk. An array holds its sorted values; a
+// run container holds sorted, disjoint [first, last] pairs; a bitmap holds
+// all 2^16 bits.
+struct container {
+    kind k{kind::array};
+    std::size_t card{};
+    std::vector<std::uint16_t> values{};
+    std::vector<std::uint64_t> words{};
+};
+
+constexpr auto num_runs(container const &c) -> std::size_t {
+    return c.values.size() / 2;
+}
+
+constexpr auto contains(container const &c, std::uint16_t v) -> bool {
+    switch (c.k) {
+    case kind::array:
+        return std::binary_search(std::cbegin(c.values), std::cend(c.values),
+                                  v);
+    case kind::bitmap:
+        return ((c.words[v / 64u] >> (v % 64u)) & 1u) != 0;
+    case kind::run: {
+        // find the first run that starts after v
+        auto lo = std::size_t{};
+        auto hi = num_runs(c);
+        while (lo < hi) {
+            auto const mid = lo + (hi - lo) / 2;
+            if (c.values[2 * mid] <= v) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo != 0 and v <= c.values[2 * (lo - 1) + 1];
+    }
+    }
+    return false;
+}
+
+template <typename F>
+constexpr auto for_each(container const &c, std::uint32_t base, F &f)
+    -> void {
+    switch (c.k) {
+    case kind::array:
+        for (auto v : c.values) {
+            f(base + v);
+        }
+        break;
+    case kind::bitmap:
+        for (auto w = std::size_t{}; w < bitmap_words; ++w) {
+            auto e = c.words[w];
+            while (e != 0) {
+                auto const offset = static_cast<std::uint32_t>(countr_zero(e));
+                e &= e - 1;
+                f(base + static_cast<std::uint32_t>(w * 64u) + offset);
+            }
+        }
+        break;
+    case kind::run:
+        for (auto r = std::size_t{}; r < num_runs(c); ++r) {
+            auto const last = std::uint32_t{c.values[2 * r + 1]};
+            for (auto v = std::uint32_t{c.values[2 * r]}; v <= last; ++v) {
+                f(base + v);
+            }
+        }
+        break;
+    }
+}
+
+constexpr auto make_bitmap(container const &c) -> std::vector<std::uint64_t> {
+    if (c.k == kind::bitmap) {
+        return c.words;
+    }
+    auto words = std::vector<std::uint64_t>(bitmap_words);
+    if (c.k == kind::array) {
+        for (auto v : c.values) {
+            words[v / 64u] |= std::uint64_t{1} << (v % 64u);
+        }
+    } else {
+        for (auto r = std::size_t{}; r < num_runs(c); ++r) {
+            bitset_words::set_range(std::data(words), c.values[2 * r],
+                                    c.values[2 * r + 1], true);
+        }
+    }
+    return words;
+}
+
+// the bits of c as bitmap words: a bitmap's own words, or else a bitmap
+// built in scratch
+constexpr auto bitmap_of(container const &c,
+                         std::vector<std::uint64_t> &scratch)
+    -> std::uint64_t const * {
+    if (c.k == kind::bitmap) {
+        return std::data(c.words);
+    }
+    scratch = make_bitmap(c);
+    return std::data(scratch);
+}
+
+// choose the smaller of array and bitmap to hold the given bits
+constexpr auto from_bitmap(std::vector<std::uint64_t> words, std::size_t card)
+    -> container {
+    if (card > array_max) {
+        return {kind::bitmap, card, {}, std::move(words)};
+    }
+    auto c = container{kind::array, card, {}, {}};
+    c.values.reserve(card);
+    auto const bm = container{kind::bitmap, card, {}, std::move(words)};
+    auto push = [&](std::uint32_t v) {
+        c.values.push_back(static_cast<std::uint16_t>(v));
+    };
+    for_each(bm, 0, push);
+    return c;
+}
+
+constexpr auto from_array(std::vector<std::uint16_t> values) -> container {
+    auto const card = values.size();
+    if (card <= array_max) {
+        return {kind::array, card, std::move(values), {}};
+    }
+    return {kind::bitmap, card, {},
+            make_bitmap(container{kind::array, card, std::move(values), {}})};
+}
+
+// runs are compact to store, but updates work on arrays and bitmaps
+constexpr auto unrun(container &c) -> void {
+    if (c.k == kind::run) {
+        c = from_bitmap(make_bitmap(c), c.card);
+    }
+}
+
+constexpr auto insert(container &c, std::uint16_t v) -> void {
+    unrun(c);
+    if (c.k == kind::array) {
+        auto it = std::lower_bound(std::begin(c.values), std::end(c.values), v);
+        if (it != std::end(c.values) and *it == v) {
+            return;
+        }
+        if (c.card < array_max) {
+            c.values.insert(it, v);
+            ++c.card;
+            return;
+        }
+        c = {kind::bitmap, c.card, {}, make_bitmap(c)};
+    }
+    auto &w = c.words[v / 64u];
+    auto const b = std::uint64_t{1} << (v % 64u);
+    if ((w & b) == 0) {
+        w |= b;
+        ++c.card;
+    }
+}
+
+constexpr auto erase(container &c, std::uint16_t v) -> void {
+    unrun(c);
+    if (c.k == kind::array) {
+        auto it = std::lower_bound(std::begin(c.values), std::end(c.values), v);
+        if (it != std::end(c.values) and *it == v) {
+            c.values.erase(it);
+            --c.card;
+        }
+        return;
+    }
+    auto &w = c.words[v / 64u];
+    auto const b = std::uint64_t{1} << (v % 64u);
+    if ((w & b) != 0) {
+        w &= ~b;
+        if (--c.card <= bitmap_min) {
+            c = from_bitmap(std::move(c.words), c.card);
+        }
+    }
+}
+
+// convert to (or from) a run container, whichever is smaller
+constexpr auto optimize(container &c) -> void {
+    auto runs = std::vector<std::uint16_t>{};
+    auto push = [&](std::uint32_t v) {
+        auto const u = static_cast<std::uint16_t>(v);
+        if (not runs.empty() and runs.back() + 1u == v) {
+            runs.back() = u;
+        } else {
+            runs.push_back(u);
+            runs.push_back(u);
+        }
+    };
+    for_each(c, 0, push);
+
+    // compare with the array or bitmap that holds the bits now (or that
+    // unrun would make): a bitmap may hold fewer than array_max bits
+    auto const is_bitmap =
+        c.k == kind::run ? c.card > array_max : c.k == kind::bitmap;
+    auto const run_bytes = runs.size() * sizeof(std::uint16_t);
+    auto const other_bytes = is_bitmap ? bitmap_words * sizeof(std::uint64_t)
+                                       : c.card * sizeof(std::uint16_t);
+    if (run_bytes < other_bytes) {
+        runs.shrink_to_fit();
+        c = {kind::run, c.card, std::move(runs), {}};
+    } else {
+        unrun(c);
+    }
+}
+
+struct or_op {
+    constexpr static auto keep_lhs = true;
+    constexpr static auto keep_rhs = true;
+    constexpr static auto word(auto x, auto y) { return x | y; }
+    template <typename It, typename Out>
+    constexpr static auto merge(It f1, It l1, It f2, It l2, Out out) {
+        return std::set_union(f1, l1, f2, l2, out);
+    }
+};
+
+struct and_op {
+    constexpr static auto keep_lhs = false;
+    constexpr static auto keep_rhs = false;
+    constexpr static auto word(auto x, auto y) { return x & y; }
+    template <typename It, typename Out>
+    constexpr static auto merge(It f1, It l1, It f2, It l2, Out out) {
+        return std::set_intersection(f1, l1, f2, l2, out);
+    }
+};
+
+struct xor_op {
+    constexpr static auto keep_lhs = true;
+    constexpr static auto keep_rhs = true;
+    constexpr static auto word(auto x, auto y) { return x ^ y; }
+    template <typename It, typename Out>
+    constexpr static auto merge(It f1, It l1, It f2, It l2, Out out) {
+        return std::set_symmetric_difference(f1, l1, f2, l2, out);
+    }
+};
+
+struct andnot_op {
+    constexpr static auto keep_lhs = true;
+    constexpr static auto keep_rhs = false;
+    constexpr static auto word(auto x, auto y) { return x & ~y; }
+    template <typename It, typename Out>
+    constexpr static auto merge(It f1, It l1, It f2, It l2, Out out) {
+        return std::set_difference(f1, l1, f2, l2, out);
+    }
+};
+
+template <bool Keep>
+constexpr auto filter(container const &c, container const &other)
+    -> container {
+    auto out = container{kind::array, 0, {}, {}};
+    for (auto v : c.values) {
+        if (contains(other, v) == Keep) {
+            out.values.push_back(v);
+        }
+    }
+    out.card = out.values.size();
+    return out;
+}
+
+template <typename Op>
+constexpr auto apply(container const &a, container const &b) -> container {
+    if (a.k == kind::array and b.k == kind::array) {
+        auto out = std::vector<std::uint16_t>{};
+        Op::merge(std::cbegin(a.values), std::cend(a.values),
+                  std::cbegin(b.values), std::cend(b.values),
+                  std::back_inserter(out));
+        return from_array(std::move(out));
+    }
+    if constexpr (std::is_same_v<Op, and_op>) {
+        if (a.k == kind::array) {
+            return filter<true>(a, b);
+        }
+        if (b.k == kind::array) {
+            return filter<true>(b, a);
+        }
+    } else if constexpr (std::is_same_v<Op, andnot_op>) {
+        if (a.k == kind::array) {
+            return filter<false>(a, b);
+        }
+    }
+    auto words = make_bitmap(a);
+    auto scratch = std::vector<std::uint64_t>{};
+    auto const *rhs = bitmap_of(b, scratch);
+    simd::transform(std::data(words), rhs, bitmap_words,
+                    [](auto x, auto y) { return Op::word(x, y); });
+    auto const card = simd::popcount(std::data(words), bitmap_words);
+    return from_bitmap(std::move(words), card);
+}
+
+constexpr auto intersection_count(container const &a, container const &b)
+    -> std::size_t {
+    if (a.k == kind::array and b.k == kind::array) {
+        auto n = std::size_t{};
+        auto i = std::cbegin(a.values);
+        auto j = std::cbegin(b.values);
+        while (i != std::cend(a.values) and j != std::cend(b.values)) {
+            if (*i < *j) {
+                ++i;
+            } else if (*j < *i) {
+                ++j;
+            } else {
+                ++n, ++i, ++j;
+            }
+        }
+        return n;
+    }
+    if (a.k == kind::array) {
+        return filter<true>(a, b).card;
+    }
+    if (b.k == kind::array) {
+        return filter<true>(b, a).card;
+    }
+    auto lhs_scratch = std::vector<std::uint64_t>{};
+    auto rhs_scratch = std::vector<std::uint64_t>{};
+    auto const *lhs = bitmap_of(a, lhs_scratch);
+    auto const *rhs = bitmap_of(b, rhs_scratch);
+    auto n = std::size_t{};
+    for (auto w = std::size_t{}; w < bitmap_words; ++w) {
+        n += static_cast<std::size_t>(popcount(lhs[w] & rhs[w]));
+    }
+    return n;
+}
+
+constexpr auto equal(container const &a, container const &b) -> bool {
+    if (a.card != b.card) {
+        return false;
+    }
+    if (a.k == b.k and a.k != kind::bitmap) {
+        return a.values == b.values;
+    }
+    auto lhs_scratch = std::vector<std::uint64_t>{};
+    auto rhs_scratch = std::vector<std::uint64_t>{};
+    return simd::equal(bitmap_of(a, lhs_scratch), bitmap_of(b, rhs_scratch),
+                       bitmap_words);
+}
+} // namespace detail::compressed
+
+// A set of 32-bit values, split into chunks of 2^16 values by the high bits.
+// Each chunk is stored as a sorted array, a bitmap or a list of runs,
+// according to which is smallest, so that memory use tracks the number of
+// members (and their clustering) rather than the size of the universe.
+class compressed_bitset {
+    using container = detail::compressed::container;
+
+    std::vector<std::uint16_t> keys{};
+    std::vector<container> chunks{};
+
+    [[nodiscard]] constexpr static auto high(std::uint32_t v) {
+        return static_cast<std::uint16_t>(v >> 16u);
+    }
+    [[nodiscard]] constexpr static auto low(std::uint32_t v) {
+        return static_cast<std::uint16_t>(v);
+    }
+
+    [[nodiscard]] constexpr auto find(std::uint16_t key) const
+        -> std::size_t {
+        return static_cast<std::size_t>(
+            std::lower_bound(std::cbegin(keys), std::cend(keys), key) -
+            std::cbegin(keys));
+    }
+
+    [[nodiscard]] constexpr auto has_chunk(std::size_t i,
+                                           std::uint16_t key) const -> bool {
+        return i < keys.size() and keys[i] == key;
+    }
+
+    constexpr auto erase_chunk(std::size_t i) -> void {
+        keys.erase(std::begin(keys) + static_cast<std::ptrdiff_t>(i));
+        chunks.erase(std::begin(chunks) + static_cast<std::ptrdiff_t>(i));
+    }
+
+    constexpr auto append(std::uint16_t key, container c) -> void {
+        keys.push_back(key);
+        chunks.push_back(std::move(c));
+    }
+
+    template <typename Op>
+    [[nodiscard]] constexpr static auto combine(compressed_bitset const &lhs,
+                                                compressed_bitset const &rhs)
+        -> compressed_bitset {
+        auto r = compressed_bitset{};
+        auto i = std::size_t{};
+        auto j = std::size_t{};
+        auto const m = lhs.keys.size();
+        auto const n = rhs.keys.size();
+        while (i < m or j < n) {
+            if (j == n or (i < m and lhs.keys[i] < rhs.keys[j])) {
+                if constexpr (Op::keep_lhs) {
+                    r.append(lhs.keys[i], lhs.chunks[i]);
+                }
+                ++i;
+            } else if (i == m or rhs.keys[j] < lhs.keys[i]) {
+                if constexpr (Op::keep_rhs) {
+                    r.append(rhs.keys[j], rhs.chunks[j]);
+                }
+                ++j;
+            } else {
+                if (auto c = detail::compressed::apply<Op>(lhs.chunks[i],
+                                                           rhs.chunks[j]);
+                    c.card != 0) {
+                    r.append(lhs.keys[i], std::move(c));
+                }
+                ++i, ++j;
+            }
+        }
+        return r;
+    }
+
+    [[nodiscard]] constexpr static auto range(std::uint32_t first,
+                                              std::uint32_t last)
+        -> compressed_bitset {
+        using detail::compressed::kind;
+        auto r = compressed_bitset{};
+        for (auto key = std::uint32_t{high(first)}; key <= high(last); ++key) {
+            auto const lo = key == high(first) ? low(first) : std::uint16_t{};
+            auto const hi =
+                key == high(last) ? low(last) : std::uint16_t{0xffffu};
+            r.append(static_cast<std::uint16_t>(key),
+                     container{kind::run, std::size_t{hi} - lo + 1u,
+                               std::vector<std::uint16_t>{lo, hi},
+                               {}});
+        }
+        return r;
+    }
+
+  public:
+    constexpr compressed_bitset() = default;
+
+    template <typename... Bs>
+    constexpr explicit compressed_bitset(place_bits_t, Bs... bs) {
+        static_assert(((std::is_integral_v<Bs> or std::is_enum_v<Bs>) and ...),
+                      "Bit places must be integral or enumeration types!");
+        (set(static_cast<std::uint32_t>(bs)), ...);
+    }
+
+    [[nodiscard]] constexpr auto operator[](std::uint32_t v) const -> bool {
+        auto const i = find(high(v));
+        return has_chunk(i, high(v)) and
+               detail::compressed::contains(chunks[i], low(v));
+    }
+
+    constexpr auto set(std::uint32_t v, bool value = true) LIFETIMEBOUND
+        -> compressed_bitset & {
+        if (not value) {
+            return reset(v);
+        }
+        auto const i = find(high(v));
+        if (not has_chunk(i, high(v))) {
+            keys.insert(std::begin(keys) + static_cast<std::ptrdiff_t>(i),
+                        high(v));
+            chunks.insert(std::begin(chunks) + static_cast<std::ptrdiff_t>(i),
+                          container{});
+        }
+        detail::compressed::insert(chunks[i], low(v));
+        return *this;
+    }
+
+    constexpr auto set(lsb_t lsb, msb_t msb, bool value = true) LIFETIMEBOUND
+        -> compressed_bitset & {
+        auto const r = range(to_underlying(lsb), to_underlying(msb));
+        if (value) {
+            *this = combine<detail::compressed::or_op>(*this, r);
+        } else {
+            *this = combine<detail::compressed::andnot_op>(*this, r);
+        }
+        return *this;
+    }
+
+    constexpr auto set(lsb_t lsb, length_t len, bool value = true) LIFETIMEBOUND
+        -> compressed_bitset & {
+        auto const l = to_underlying(lsb);
+        auto const length = to_underlying(len);
+        return set(lsb, static_cast<msb_t>(l + length - 1), value);
+    }
+
+    constexpr auto reset(std::uint32_t v) LIFETIMEBOUND
+        -> compressed_bitset & {
+        if (auto const i = find(high(v)); has_chunk(i, high(v))) {
+            detail::compressed::erase(chunks[i], low(v));
+            if (chunks[i].card == 0) {
+                erase_chunk(i);
+            }
+        }
+        return *this;
+    }
+
+    constexpr auto reset(lsb_t lsb, msb_t msb) LIFETIMEBOUND
+        -> compressed_bitset & {
+        return set(lsb, msb, false);
+    }
+
+    constexpr auto reset(lsb_t lsb, length_t len) LIFETIMEBOUND
+        -> compressed_bitset & {
+        return set(lsb, len, false);
+    }
+
+    constexpr auto reset() LIFETIMEBOUND -> compressed_bitset & {
+        keys.clear();
+        chunks.clear();
+        return *this;
+    }
+
+    template <typename... Ts>
+    constexpr auto clear(Ts... ts) LIFETIMEBOUND -> compressed_bitset & {
+        return reset(ts...);
+    }
+
+    constexpr auto flip(std::uint32_t v) LIFETIMEBOUND -> compressed_bitset & {
+        return set(v, not(*this)[v]);
+    }
+
+    // re-encode each chunk as runs where that is smaller
+    constexpr auto optimize() LIFETIMEBOUND -> compressed_bitset & {
+        for (auto &c : chunks) {
+            detail::compressed::optimize(c);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] constexpr auto count() const -> std::size_t {
+        auto n = std::size_t{};
+        for (auto const &c : chunks) {
+            n += c.card;
+        }
+        return n;
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t { return count(); }
+    [[nodiscard]] constexpr auto empty() const -> bool { return keys.empty(); }
+    [[nodiscard]] constexpr auto any() const -> bool { return not empty(); }
+    [[nodiscard]] constexpr auto none() const -> bool { return empty(); }
+
+    // the number of bytes used by the chunk containers
+    [[nodiscard]] constexpr auto storage_bytes() const -> std::size_t {
+        auto n = keys.size() * (sizeof(std::uint16_t) + sizeof(container));
+        for (auto const &c : chunks) {
+            n += c.values.size() * sizeof(std::uint16_t) +
+                 c.words.size() * sizeof(std::uint64_t);
+        }
+        return n;
+    }
+
+    template <typename F> constexpr auto for_each(F &&f) const -> F {
+        for (auto i = std::size_t{}; i < keys.size(); ++i) {
+            detail::compressed::for_each(
+                chunks[i], static_cast<std::uint32_t>(keys[i]) << 16u, f);
+        }
+        return std::forward<F>(f);
+    }
+
+    template <typename T, typename F, typename R>
+    constexpr auto transform_reduce(F &&f, R &&r, T init) const -> T {
+        for_each([&](std::uint32_t i) { init = r(std::move(init), f(i)); });
+        return init;
+    }
+
+    constexpr auto operator|=(compressed_bitset const &rhs) LIFETIMEBOUND
+        -> compressed_bitset & {
+        *this = combine<detail::compressed::or_op>(*this, rhs);
+        return *this;
+    }
+
+    constexpr auto operator&=(compressed_bitset const &rhs) LIFETIMEBOUND
+        -> compressed_bitset & {
+        *this = combine<detail::compressed::and_op>(*this, rhs);
+        return *this;
+    }
+
+    constexpr auto operator^=(compressed_bitset const &rhs) LIFETIMEBOUND
+        -> compressed_bitset & {
+        *this = combine<detail::compressed::xor_op>(*this, rhs);
+        return *this;
+    }
+
+    constexpr auto operator-=(compressed_bitset const &rhs) LIFETIMEBOUND
+        -> compressed_bitset & {
+        *this = combine<detail::compressed::andnot_op>(*this, rhs);
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr auto operator|(compressed_bitset const &lhs,
+                                                  compressed_bitset const &rhs)
+        -> compressed_bitset {
+        return combine<detail::compressed::or_op>(lhs, rhs);
+    }
+
+    [[nodiscard]] friend constexpr auto operator&(compressed_bitset const &lhs,
+                                                  compressed_bitset const &rhs)
+        -> compressed_bitset {
+        return combine<detail::compressed::and_op>(lhs, rhs);
+    }
+
+    [[nodiscard]] friend constexpr auto operator^(compressed_bitset const &lhs,
+                                                  compressed_bitset const &rhs)
+        -> compressed_bitset {
+        return combine<detail::compressed::xor_op>(lhs, rhs);
+    }
+
+    [[nodiscard]] friend constexpr auto operator-(compressed_bitset const &lhs,
+                                                  compressed_bitset const &rhs)
+        -> compressed_bitset {
+        return combine<detail::compressed::andnot_op>(lhs, rhs);
+    }
+
+    // the size of the intersection, without materializing it
+    [[nodiscard]] friend constexpr auto
+    intersection_count(compressed_bitset const &lhs,
+                       compressed_bitset const &rhs) -> std::size_t {
+        auto n = std::size_t{};
+        auto i = std::size_t{};
+        auto j = std::size_t{};
+        while (i < lhs.keys.size() and j < rhs.keys.size()) {
+            if (lhs.keys[i] < rhs.keys[j]) {
+                ++i;
+            } else if (rhs.keys[j] < lhs.keys[i]) {
+                ++j;
+            } else {
+                n += detail::compressed::intersection_count(lhs.chunks[i],
+                                                            rhs.chunks[j]);
+                ++i, ++j;
+            }
+        }
+        return n;
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(compressed_bitset const &lhs,
+                                                   compressed_bitset const &rhs)
+        -> bool {
+        return lhs.keys == rhs.keys and
+               std::equal(std::cbegin(lhs.chunks), std::cend(lhs.chunks),
+                          std::cbegin(rhs.chunks),
+                          [](auto const &a, auto const &b) {
+                              return detail::compressed::equal(a, b);
+                          });
+    }
+};
+
+template <typename F>
+constexpr auto for_each(F &&f, compressed_bitset const &bs) -> F {
+    return bs.for_each(std::forward<F>(f));
+}
+
+template <typename T, typename F, typename R>
+[[nodiscard]] constexpr auto transform_reduce(F &&f, R &&r, T init,
+                                              compressed_bitset const &bs)
+    -> T {
+    return bs.transform_reduce(std::forward<F>(f), std::forward<R>(r),
+                               std::move(init));
+}
+} // namespace v1
+} // namespace stdx
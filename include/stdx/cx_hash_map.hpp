@@ -0,0 +1,269 @@
+#pragma once
+
+#include <stdx/bit.hpp>
+#include <stdx/compiler.hpp>
+#include <stdx/concepts.hpp>
+#include <stdx/cx_map.hpp>
+#include <stdx/detail/simd.hpp>
+#include <stdx/hash.hpp>
+#include <stdx/iterator.hpp>
+#include <stdx/utility.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace stdx {
+inline namespace v1 {
+namespace detail::swiss {
+using detail::simd::group_width;
+
+// A control byte is empty, deleted, or the low 7 bits of a full slot's hash.
+constexpr inline auto empty = std::uint8_t{0x80};
+constexpr inline auto deleted = std::uint8_t{0xfe};
+
+[[nodiscard]] constexpr auto tag(std::uint64_t h) -> std::uint8_t {
+    return static_cast<std::uint8_t>(h & 0x7fu);
+}
+
+// a power of two number of groups, so that there is always an empty slot
+// even with N entries: the table is at most 7/8 full
+template <std::size_t N> constexpr auto num_slots() -> std::size_t {
+    return bit_ceil(N / 14 + 1) * group_width;
+}
+
+template <std::size_t N>
+using index_t =
+    std::conditional_t<(N <= std::numeric_limits<std::uint16_t>::max()),
+                       std::uint16_t, std::uint32_t>;
+} // namespace detail::swiss
+
+// An unordered map with a compile-time capacity and the interface of cx_map,
+// whose lookups are O(1) instead of a linear scan. The entries are kept dense
+// (as in cx_map) and indexed by an open-addressing table of SwissTable-style
+// control bytes, which are probed a group of 16 at a time.
+template <typename Key, typename Value, std::size_t N, typename Hash = cx_hash>
+class cx_hash_map {
+  public:
+    using value_type = cx_map_value<Key, Value>;
+    using key_type = typename value_type::key_type;
+    using mapped_type = typename value_type::mapped_type;
+    using size_type = std::size_t;
+    using reference = value_type &;
+    using const_reference = value_type const &;
+    using iterator = value_type *;
+    using const_iterator = value_type const *;
+
+  private:
+    constexpr static auto num_slots = detail::swiss::num_slots<N>();
+    constexpr static auto group_mask =
+        num_slots / detail::swiss::group_width - 1;
+    constexpr static auto max_load = num_slots / 8 * 7;
+    constexpr static auto npos = std::numeric_limits<std::size_t>::max();
+    using index_t = detail::swiss::index_t<N>;
+
+    std::array<value_type, N> storage{};
+    std::size_t current_size{};
+    std::size_t tombstones{};
+    std::array<std::uint8_t, num_slots> ctrl{[] {
+        std::array<std::uint8_t, num_slots> c{};
+        c.fill(detail::swiss::empty);
+        return c;
+    }()};
+    std::array<index_t, num_slots> slot_index{};
+    [[no_unique_address]] Hash hash{};
+
+    [[nodiscard]] constexpr auto match(std::size_t group, std::uint8_t c) const
+        -> std::uint32_t {
+        return detail::simd::match_bytes(
+            std::data(ctrl) + group * detail::swiss::group_width, c);
+    }
+
+    // triangular probing visits every group once
+    template <typename F>
+    constexpr auto probe(std::uint64_t h, F &&f) const -> std::size_t {
+        auto group = (h >> 7u) & group_mask;
+        for (auto step = std::size_t{1};; ++step) {
+            if (auto const s = f(group); s != npos) {
+                return s;
+            }
+            group = (group + step) & group_mask;
+        }
+    }
+
+    [[nodiscard]] constexpr auto find_slot(key_type const &key) const
+        -> std::size_t {
+        auto const h = hash(key);
+        auto const t = detail::swiss::tag(h);
+        auto const s = probe(h, [&](auto group) {
+            for (auto m = match(group, t); m != 0; m &= m - 1) {
+                auto const i = group * detail::swiss::group_width +
+                               static_cast<std::size_t>(countr_zero(m));
+                if (storage[slot_index[i]].key == key) {
+                    return i;
+                }
+            }
+            return match(group, detail::swiss::empty) != 0 ? num_slots
+                                                           : npos;
+        });
+        return s == num_slots ? npos : s;
+    }
+
+    [[nodiscard]] constexpr auto free_slot(std::uint64_t h) const
+        -> std::size_t {
+        return probe(h, [&](auto group) {
+            auto const m = match(group, detail::swiss::empty) |
+                           match(group, detail::swiss::deleted);
+            return m == 0 ? npos
+                          : group * detail::swiss::group_width +
+                                static_cast<std::size_t>(countr_zero(m));
+        });
+    }
+
+    constexpr auto claim_slot(std::size_t i) -> void {
+        auto const h = hash(storage[i].key);
+        auto const s = free_slot(h);
+        if (ctrl[s] == detail::swiss::deleted) {
+            --tombstones;
+        }
+        ctrl[s] = detail::swiss::tag(h);
+        slot_index[s] = static_cast<index_t>(i);
+    }
+
+    // a probe for any key stops at a group with an empty slot, so a slot in
+    // such a group can be emptied; otherwise it must be marked deleted
+    constexpr auto release_slot(std::size_t s) -> void {
+        auto const group = s / detail::swiss::group_width;
+        if (match(group, detail::swiss::empty) != 0) {
+            ctrl[s] = detail::swiss::empty;
+        } else {
+            ctrl[s] = detail::swiss::deleted;
+            ++tombstones;
+        }
+    }
+
+    // drops the tombstones by indexing the entries afresh
+    constexpr auto rehash() -> void {
+        ctrl.fill(detail::swiss::empty);
+        tombstones = 0;
+        for (auto i = std::size_t{}; i < current_size; ++i) {
+            claim_slot(i);
+        }
+    }
+
+    // removes the entry in slot s, moving the last entry into its place
+    constexpr auto remove(std::size_t s) -> value_type {
+        release_slot(s);
+        auto const i = std::size_t{slot_index[s]};
+        auto removed = std::move(storage[i]);
+        if (auto const last = --current_size; i != last) {
+            slot_index[find_slot(storage[last].key)] = static_cast<index_t>(i);
+            storage[i] = std::move(storage[last]);
+        }
+        return removed;
+    }
+
+  public:
+    constexpr cx_hash_map() = default;
+    constexpr explicit cx_hash_map(Hash h) : hash{std::move(h)} {}
+
+    template <same_as<value_type>... Vs>
+        requires(sizeof...(Vs) <= N)
+    constexpr explicit cx_hash_map(Vs const &...vs) {
+        (insert_or_assign(vs.key, vs.value), ...);
+    }
+
+    [[nodiscard]] constexpr auto begin() LIFETIMEBOUND -> iterator {
+        return std::data(storage);
+    }
+    [[nodiscard]] constexpr auto begin() const LIFETIMEBOUND -> const_iterator {
+        return std::data(storage);
+    }
+    [[nodiscard]] constexpr auto cbegin() const LIFETIMEBOUND
+        -> const_iterator {
+        return std::data(storage);
+    }
+
+    [[nodiscard]] constexpr auto end() LIFETIMEBOUND -> iterator {
+        return begin() + current_size;
+    }
+    [[nodiscard]] constexpr auto end() const LIFETIMEBOUND -> const_iterator {
+        return begin() + current_size;
+    }
+    [[nodiscard]] constexpr auto cend() const LIFETIMEBOUND -> const_iterator {
+        return cbegin() + current_size;
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        return current_size;
+    }
+    constexpr static std::integral_constant<size_type, N> capacity{};
+
+    [[nodiscard]] constexpr auto full() const -> bool {
+        return current_size == N;
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        return current_size == 0;
+    }
+
+    constexpr auto clear() -> void {
+        current_size = 0;
+        rehash();
+    }
+
+    [[nodiscard]] constexpr auto pop_back() -> value_type {
+        return remove(find_slot(storage[current_size - 1].key));
+    }
+
+    [[nodiscard]] constexpr auto get(key_type const &key) LIFETIMEBOUND
+        -> mapped_type & {
+        if (auto const s = find_slot(key); s != npos) {
+            return storage[slot_index[s]].value;
+        }
+        unreachable();
+    }
+    [[nodiscard]] constexpr auto get(key_type const &key) const LIFETIMEBOUND
+        -> mapped_type const & {
+        if (auto const s = find_slot(key); s != npos) {
+            return storage[slot_index[s]].value;
+        }
+        unreachable();
+    }
+
+    [[nodiscard]] constexpr auto contains(key_type const &key) const -> bool {
+        return find_slot(key) != npos;
+    }
+
+    constexpr auto insert_or_assign(key_type const &key,
+                                    mapped_type const &value) -> bool {
+        if (auto const s = find_slot(key); s != npos) {
+            storage[slot_index[s]].value = value;
+            return false;
+        }
+        if (current_size + tombstones >= max_load) {
+            rehash();
+        }
+        storage[current_size] = {key, value};
+        claim_slot(current_size++);
+        return true;
+    }
+    constexpr auto put(key_type const &key, mapped_type const &value) -> bool {
+        return insert_or_assign(key, value);
+    }
+
+    constexpr auto erase(key_type const &key) -> size_type {
+        if (auto const s = find_slot(key); s != npos) {
+            remove(s);
+            return 1u;
+        }
+        return 0u;
+    }
+};
+
+template <typename K, typename V, std::size_t N, typename H>
+constexpr auto ct_capacity_v<cx_hash_map<K, V, N, H>> = N;
+} // namespace v1
+} // namespace stdx
@@ -3,6 +3,7 @@
 #include <stdx/compiler.hpp>
 #include <stdx/concepts.hpp>
 #include <stdx/cx_map.hpp>
+#include <stdx/detail/simd.hpp>
 #include <stdx/iterator.hpp>
 
 #include <cstddef>
@@ -13,6 +14,12 @@ template <typename Key, std::size_t N> class cx_set {
     std::array<Key, N> storage{};
     std::size_t current_size{};
 
+    // integral and enum keys are compared a vector at a time at runtime
+    [[nodiscard]] constexpr auto index_of(Key const &key) const
+        -> std::size_t {
+        return detail::simd::find(std::data(storage), current_size, key);
+    }
+
   public:
     using key_type = Key;
     using value_type = Key;
@@ -55,12 +62,7 @@ template <typename Key, std::size_t N> class cx_set {
     constexpr static std::integral_constant<size_type, N> capacity{};
 
     [[nodiscard]] constexpr auto contains(key_type const &key) const -> bool {
-        for (auto const &k : *this) {
-            if (k == key) {
-                return true;
-            }
-        }
-        return false;
+        return index_of(key) != current_size;
     }
 
     constexpr auto insert(key_type const &key) -> bool {
@@ -79,11 +81,9 @@ template <typename Key, std::size_t N> class cx_set {
     }
 
     constexpr auto erase(key_type const &key) -> size_type {
-        for (auto &k : *this) {
-            if (k == key) {
-                k = storage[--current_size];
-                return 1u;
-            }
+        if (auto const i = index_of(key); i != current_size) {
+            storage[i] = storage[--current_size];
+            return 1u;
         }
         return 0u;
     }
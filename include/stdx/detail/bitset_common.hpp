@@ -1,10 +1,359 @@
 #pragma once
 
+#include <stdx/bit.hpp>
+#include <stdx/detail/simd.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
 namespace stdx {
 inline namespace v1 {
 struct place_bits_t {};
 constexpr inline auto place_bits = place_bits_t{};
 struct all_bits_t {};
 constexpr inline auto all_bits = all_bits_t{};
+
+struct set_bit {
+    template <auto Bit, typename IterArg, auto Mask>
+    constexpr static auto fn(auto e, auto idx, auto &f) {
+        using elem_t = decltype(Bit);
+        while (e != 0) {
+            auto const offset = static_cast<std::size_t>(countr_zero(e));
+            e &= static_cast<elem_t>(~(Bit << offset));
+            f(static_cast<IterArg>(idx + offset));
+        }
+    }
+};
+struct unset_bit {
+    template <auto Bit, typename IterArg, auto Mask>
+    constexpr static auto fn(auto e, auto idx, auto &f) {
+        using elem_t = decltype(Bit);
+        while (e != Mask) {
+            auto const offset = static_cast<std::size_t>(countr_one(e));
+            e |= static_cast<elem_t>(Bit << offset);
+            f(static_cast<IterArg>(idx + offset));
+        }
+    }
+};
+struct bit {
+    template <auto Bit, typename IterArg, auto Mask>
+    constexpr static auto fn(auto e, auto idx, auto &f) {
+        using elem_t = decltype(Bit);
+        for (auto i = std::size_t{}; i < popcount(Mask); ++i) {
+            bool b = e & static_cast<elem_t>(Bit << i);
+            f(static_cast<IterArg>(idx + i), b);
+        }
+    }
+};
+
+namespace detail {
+template <typename T>
+concept bit_spec = std::same_as<T, set_bit> or std::same_as<T, unset_bit> or
+                   std::same_as<T, bit>;
+
+// Word-wise algorithms shared by the bitset types. They work on a pointer to
+// the storage words and the number of words; bits above the salient size in
+// the last word are "don't care" and must be masked by the caller where
+// necessary.
+namespace bitset_words {
+template <typename Elem>
+constexpr auto set_range(Elem *storage, std::size_t lsb, std::size_t msb,
+                         bool value) -> void {
+    constexpr auto digits = std::size_t{std::numeric_limits<Elem>::digits};
+    constexpr auto allbits = std::numeric_limits<Elem>::max();
+    auto l_index = lsb / digits;
+    auto const l_offset = lsb % digits;
+    auto const m_index = msb / digits;
+    auto const m_offset = msb % digits;
+
+    using setfn = auto (*)(Elem *, Elem)->void;
+    auto const fn = [&]() -> setfn {
+        if (value) {
+            return [](Elem *ptr, Elem val) { *ptr |= val; };
+        }
+        return [](Elem *ptr, Elem val) { *ptr &= static_cast<Elem>(~val); };
+    }();
+
+    auto l_mask = allbits << l_offset;
+    if (l_index != m_index) {
+        fn(&storage[l_index++], static_cast<Elem>(l_mask));
+        l_mask = allbits;
+    }
+    while (l_index != m_index) {
+        fn(&storage[l_index++], static_cast<Elem>(l_mask));
+    }
+    auto const m_mask = allbits >> (digits - m_offset - 1);
+    fn(&storage[l_index], static_cast<Elem>(l_mask & m_mask));
+}
+
+template <typename IterArg, typename Elem>
+[[nodiscard]] constexpr auto lowest_unset(Elem const *storage, std::size_t n)
+    -> IterArg {
+    constexpr auto digits = std::size_t{std::numeric_limits<Elem>::digits};
+    std::size_t i = 0;
+    for (auto const *p = storage; p != storage + n; ++p) {
+        if (auto offset = static_cast<std::size_t>(countr_one(*p));
+            offset != digits) {
+            return static_cast<IterArg>(i + offset);
+        }
+        i += digits;
+    }
+    return static_cast<IterArg>(i);
+}
+
+// word w with the bits of interest to Spec set, and bits beyond the size unset
+template <typename Spec, typename Elem>
+[[nodiscard]] constexpr auto search_word(Elem const *storage, std::size_t n,
+                                         Elem lastmask, std::size_t w)
+    -> Elem {
+    auto const e = std::is_same_v<Spec, unset_bit>
+                       ? static_cast<Elem>(~storage[w])
+                       : storage[w];
+    return w == n - 1 ? static_cast<Elem>(e & lastmask) : e;
+}
+
+// the lowest Spec bit at or above pos, or nbits if there is none
+template <typename Spec, typename Elem>
+[[nodiscard]] constexpr auto find_from(Elem const *storage, std::size_t n,
+                                       Elem lastmask, std::size_t nbits,
+                                       std::size_t pos) -> std::size_t {
+    constexpr auto digits = std::size_t{std::numeric_limits<Elem>::digits};
+    constexpr auto allbits = std::numeric_limits<Elem>::max();
+    if (pos >= nbits) {
+        return nbits;
+    }
+    auto w = pos / digits;
+    auto e = static_cast<Elem>(search_word<Spec>(storage, n, lastmask, w) &
+                               static_cast<Elem>(allbits << (pos % digits)));
+    while (e == 0) {
+        if (++w == n) {
+            return nbits;
+        }
+        e = search_word<Spec>(storage, n, lastmask, w);
+    }
+    return w * digits + static_cast<std::size_t>(countr_zero(e));
+}
+
+// the highest Spec bit at or below pos, or nbits if there is none
+template <typename Spec, typename Elem>
+[[nodiscard]] constexpr auto find_to(Elem const *storage, std::size_t n,
+                                     Elem lastmask, std::size_t nbits,
+                                     std::size_t pos) -> std::size_t {
+    constexpr auto digits = std::size_t{std::numeric_limits<Elem>::digits};
+    constexpr auto allbits = std::numeric_limits<Elem>::max();
+    if (nbits == 0) {
+        return nbits;
+    }
+    pos = std::min(pos, nbits - 1);
+    auto w = pos / digits;
+    auto e = static_cast<Elem>(
+        search_word<Spec>(storage, n, lastmask, w) &
+        static_cast<Elem>(allbits >> (digits - 1 - pos % digits)));
+    while (e == 0) {
+        if (w == 0) {
+            return nbits;
+        }
+        e = search_word<Spec>(storage, n, lastmask, --w);
+    }
+    return w * digits + digits - 1 - static_cast<std::size_t>(countl_zero(e));
+}
+
+template <typename IterArg, typename Elem, typename T, typename F, typename R>
+constexpr auto transform_reduce(Elem const *storage, std::size_t n,
+                                Elem lastmask, F &f, R &r, T init) -> T {
+    constexpr auto digits = std::size_t{std::numeric_limits<Elem>::digits};
+    std::size_t i = 0;
+    for (auto w = std::size_t{}; w < n; ++w) {
+        auto e = w == n - 1 ? static_cast<Elem>(storage[w] & lastmask)
+                            : storage[w];
+        while (e != 0) {
+            auto const offset = static_cast<std::size_t>(countr_zero(e));
+            e &= static_cast<Elem>(~(Elem{1} << offset));
+            init = r(std::move(init), f(static_cast<IterArg>(i + offset)));
+        }
+        i += digits;
+    }
+    return init;
+}
+
+// the offsets of the set bits in each byte value, packed at the front
+constexpr inline auto byte_offsets = [] {
+    auto r = std::array<std::array<std::uint8_t, 8>, 256>{};
+    for (auto b = 0u; b < 256u; ++b) {
+        auto n = 0u;
+        for (auto i = 0u; i < 8u; ++i) {
+            if (((b >> i) & 1u) != 0) {
+                r[b][n++] = static_cast<std::uint8_t>(i);
+            }
+        }
+    }
+    return r;
+}();
+
+// Write the indices of the set bits at or above pos to out (of capacity cap)
+// in increasing order, stopping when out is full. Returns the number written.
+template <typename T, typename Elem>
+constexpr auto decode(Elem const *storage, std::size_t n, Elem lastmask,
+                      std::size_t pos, T *out, std::size_t cap)
+    -> std::size_t {
+    constexpr auto digits = std::size_t{std::numeric_limits<Elem>::digits};
+    constexpr auto allbits = std::numeric_limits<Elem>::max();
+    auto written = std::size_t{};
+    for (auto w = pos / digits; w < n; ++w) {
+        auto e = storage[w];
+        if (w == n - 1) {
+            e &= lastmask;
+        }
+        if (w == pos / digits) {
+            e &= static_cast<Elem>(allbits << (pos % digits));
+        }
+        auto base = w * digits;
+        if (cap - written >= digits) {
+            // Table-driven: each byte writes all 8 of its table entries and
+            // advances by its popcount. The surplus entries are overwritten
+            // later, and never go past the room for a whole word.
+            while (e != 0) {
+                auto const byte = static_cast<std::uint8_t>(e);
+                auto const &offsets = byte_offsets[byte];
+                for (auto k = std::size_t{}; k < 8u; ++k) {
+                    out[written + k] = static_cast<T>(base + offsets[k]);
+                }
+                written += static_cast<std::size_t>(popcount(byte));
+                e = static_cast<Elem>(e >> 8u);
+                base += 8u;
+            }
+        } else {
+            while (e != 0) {
+                if (written == cap) {
+                    return written;
+                }
+                auto const offset = static_cast<std::size_t>(countr_zero(e));
+                e &= static_cast<Elem>(e - 1u);
+                out[written++] = static_cast<T>(base + offset);
+            }
+        }
+    }
+    return written;
+}
+
+template <typename Elem>
+constexpr auto shift_left(Elem *storage, std::size_t n, std::size_t pos)
+    -> void {
+    constexpr auto digits = std::size_t{std::numeric_limits<Elem>::digits};
+    auto dst = n - 1;
+    auto const start = dst - (pos / digits);
+    pos %= digits;
+
+    if (pos == 0) {
+        for (auto i = start; i > std::size_t{}; --i) {
+            storage[dst] = storage[i];
+            --dst;
+        }
+    } else {
+        auto const words = dst - start;
+        simd::funnel_shift_left(storage + words + 1, storage, start, pos);
+        dst = words;
+    }
+    storage[dst] = static_cast<Elem>(storage[0] << pos);
+    while (dst > std::size_t{}) {
+        storage[--dst] = 0;
+    }
+}
+
+template <typename Elem>
+constexpr auto shift_right(Elem *storage, std::size_t n, std::size_t pos)
+    -> void {
+    constexpr auto digits = std::size_t{std::numeric_limits<Elem>::digits};
+    auto dst = std::size_t{};
+    auto const start = pos / digits;
+    pos %= digits;
+
+    if (pos == 0) {
+        for (auto i = start; i < n - 1; ++i) {
+            storage[dst] = storage[i];
+            ++dst;
+        }
+    } else {
+        auto const count = start < n ? n - 1 - start : 0;
+        simd::funnel_shift_right(storage, storage + start, count, pos);
+        dst += count;
+    }
+    storage[dst++] = static_cast<Elem>(storage[n - 1] >> pos);
+    while (dst < n) {
+        storage[dst++] = 0;
+    }
+}
+} // namespace bitset_words
+
+// A bidirectional iterator over the set (or unset) bits of a bitset, using
+// the bitset's find_next and find_prev. The end iterator is at capacity().
+template <typename Bitset, typename Spec, typename IterArg>
+class bit_iterator {
+    Bitset const *bs{};
+    std::size_t pos{};
+
+  public:
+    using value_type = IterArg;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    constexpr bit_iterator() = default;
+    constexpr bit_iterator(Bitset const *b, std::size_t p) : bs{b}, pos{p} {}
+
+    [[nodiscard]] constexpr auto operator*() const -> value_type {
+        return static_cast<value_type>(pos);
+    }
+
+    constexpr auto operator++() -> bit_iterator & {
+        pos = bs->template find_next<Spec>(pos);
+        return *this;
+    }
+    constexpr auto operator++(int) -> bit_iterator {
+        auto tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    constexpr auto operator--() -> bit_iterator & {
+        pos = pos >= bs->capacity() ? bs->template find_last<Spec>()
+                                    : bs->template find_prev<Spec>(pos);
+        return *this;
+    }
+    constexpr auto operator--(int) -> bit_iterator {
+        auto tmp = *this;
+        --(*this);
+        return tmp;
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(bit_iterator const &lhs,
+                                                   bit_iterator const &rhs)
+        -> bool {
+        return lhs.pos == rhs.pos;
+    }
+};
+
+template <typename Bitset, typename Spec, typename IterArg> class bit_range {
+    Bitset const *bs;
+
+  public:
+    using iterator = bit_iterator<Bitset, Spec, IterArg>;
+
+    constexpr explicit bit_range(Bitset const &b) : bs{&b} {}
+
+    [[nodiscard]] constexpr auto begin() const -> iterator {
+        return {bs, bs->template find_first<Spec>()};
+    }
+    [[nodiscard]] constexpr auto end() const -> iterator {
+        return {bs, bs->capacity()};
+    }
+};
+} // namespace detail
 } // namespace v1
 } // namespace stdx
@@ -0,0 +1,434 @@
+#pragma once
+
+#include <stdx/bit.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+
+#ifndef STDX_SIMD_WIDTH
+#if defined(__AVX512F__)
+#define STDX_SIMD_WIDTH 64
+#elif defined(__AVX2__)
+#define STDX_SIMD_WIDTH 32
+#elif defined(__SSE2__) or defined(__ARM_NEON)
+#define STDX_SIMD_WIDTH 16
+#else
+#define STDX_SIMD_WIDTH 0
+#endif
+#endif
+
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+namespace stdx {
+inline namespace v1 {
+namespace detail::simd {
+// Kernels over contiguous arrays of unsigned words. Each kernel is constexpr:
+// during constant evaluation it runs the plain scalar loop; at runtime it
+// works in blocks of STDX_SIMD_WIDTH bytes using compiler vector extensions
+// (so it is SSE2, AVX2, AVX-512 or NEON according to the target) and finishes
+// the tail with the same scalar loop. The results are bit-identical.
+
+constexpr inline std::size_t width = STDX_SIMD_WIDTH;
+
+#if STDX_SIMD_WIDTH != 0
+template <typename T> struct vec {
+    // NOLINTNEXTLINE(modernize-use-using)
+    typedef T type __attribute__((vector_size(STDX_SIMD_WIDTH)));
+};
+template <typename T> using vec_t = typename vec<T>::type;
+
+template <typename T> constexpr inline std::size_t lanes = width / sizeof(T);
+
+template <typename T> auto load(T const *p) -> vec_t<T> {
+    vec_t<T> v;
+    std::memcpy(&v, p, width);
+    return v;
+}
+
+template <typename T> auto store(T *p, vec_t<T> const &v) -> void {
+    std::memcpy(p, &v, width);
+}
+
+template <typename T> auto is_zero(vec_t<T> const &v) -> bool {
+    auto const u = bit_cast<vec_t<std::uint64_t>>(v);
+    std::uint64_t r{};
+    for (auto i = std::size_t{}; i < lanes<std::uint64_t>; ++i) {
+        r |= u[i];
+    }
+    return r == 0;
+}
+#endif
+
+template <typename T, typename Op>
+constexpr auto transform(T *dst, T const *src, std::size_t n, Op op) -> void {
+    static_assert(std::is_unsigned_v<T>);
+    auto i = std::size_t{};
+#if STDX_SIMD_WIDTH != 0
+    if (not std::is_constant_evaluated()) {
+        for (auto const end = n - n % lanes<T>; i < end; i += lanes<T>) {
+            store(dst + i, vec_t<T>(op(load(dst + i), load(src + i))));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = static_cast<T>(op(dst[i], src[i]));
+    }
+}
+
+template <typename T, typename Op>
+constexpr auto transform(T *dst, std::size_t n, Op op) -> void {
+    static_assert(std::is_unsigned_v<T>);
+    auto i = std::size_t{};
+#if STDX_SIMD_WIDTH != 0
+    if (not std::is_constant_evaluated()) {
+        for (auto const end = n - n % lanes<T>; i < end; i += lanes<T>) {
+            store(dst + i, vec_t<T>(op(load(dst + i))));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = static_cast<T>(op(dst[i]));
+    }
+}
+
+template <typename T>
+[[nodiscard]] constexpr auto equal(T const *lhs, T const *rhs, std::size_t n)
+    -> bool {
+    static_assert(std::is_unsigned_v<T>);
+    auto i = std::size_t{};
+#if STDX_SIMD_WIDTH != 0
+    if (not std::is_constant_evaluated()) {
+        for (auto const end = n - n % lanes<T>; i < end; i += lanes<T>) {
+            if (not is_zero<T>(load(lhs + i) ^ load(rhs + i))) {
+                return false;
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (lhs[i] != rhs[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if STDX_SIMD_WIDTH != 0
+// per-byte popcounts, accumulated in byte lanes (at most 8 per block)
+inline auto byte_popcounts(vec_t<std::uint64_t> v) -> vec_t<std::uint64_t> {
+    constexpr auto m1 = std::uint64_t{0x5555'5555'5555'5555u};
+    constexpr auto m2 = std::uint64_t{0x3333'3333'3333'3333u};
+    constexpr auto m4 = std::uint64_t{0x0f0f'0f0f'0f0f'0f0fu};
+    v = v - ((v >> 1u) & m1);
+    v = (v & m2) + ((v >> 2u) & m2);
+    return (v + (v >> 4u)) & m4;
+}
+
+inline auto sum_bytes(vec_t<std::uint64_t> const &v) -> std::size_t {
+    constexpr auto m8 = std::uint64_t{0x00ff'00ff'00ff'00ffu};
+    constexpr auto h16 = std::uint64_t{0x0001'0001'0001'0001u};
+    auto n = std::size_t{};
+    for (auto i = std::size_t{}; i < lanes<std::uint64_t>; ++i) {
+        auto const s = (v[i] & m8) + ((v[i] >> 8u) & m8);
+        n += (s * h16) >> 48u;
+    }
+    return n;
+}
+#endif
+
+// Kernels over generated words: g.template get<T>(i) gives word i and (at
+// runtime) g.template get<vec_t<T>>(i) gives the block starting at word i.
+// This lets a lazy expression be evaluated in a single pass.
+template <typename T, typename G>
+constexpr auto generate(T *dst, std::size_t n, G const &g) -> void {
+    static_assert(std::is_unsigned_v<T>);
+    auto i = std::size_t{};
+#if STDX_SIMD_WIDTH != 0
+    if (not std::is_constant_evaluated()) {
+        for (auto const end = n - n % lanes<T>; i < end; i += lanes<T>) {
+            store(dst + i, g.template get<vec_t<T>>(i));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = g.template get<T>(i);
+    }
+}
+
+#if STDX_SIMD_WIDTH != 0
+// carry-save adder: (high, low) = a + b + c, bitwise
+inline auto csa(vec_t<std::uint64_t> &high, vec_t<std::uint64_t> &low,
+                vec_t<std::uint64_t> a, vec_t<std::uint64_t> b,
+                vec_t<std::uint64_t> c) -> void {
+    auto const u = a ^ b;
+    high = (a & b) | (u & c);
+    low = u ^ c;
+}
+
+inline auto vec_popcount(vec_t<std::uint64_t> v) -> std::size_t {
+    return sum_bytes(byte_popcounts(v));
+}
+
+// Harley-Seal: a tree of carry-save adders reduces 16 blocks to one block of
+// "sixteens", so only one popcount is needed for every 16 blocks. Returns
+// the count of the blocks in [i, i + 16k) and advances i.
+template <typename T, typename G>
+auto harley_seal(G const &g, std::size_t &i, std::size_t n) -> std::size_t {
+    using V = vec_t<std::uint64_t>;
+    constexpr auto stride = lanes<T>;
+    auto const block = [&](std::size_t k) {
+        return bit_cast<V>(g.template get<vec_t<T>>(i + k * stride));
+    };
+
+    V ones{}, twos{}, fours{}, eights{};
+    V twos_a, twos_b, fours_a, fours_b, eights_a, eights_b, sixteens;
+    auto count = std::size_t{};
+    for (; i + 16 * stride <= n; i += 16 * stride) {
+        csa(twos_a, ones, ones, block(0), block(1));
+        csa(twos_b, ones, ones, block(2), block(3));
+        csa(fours_a, twos, twos, twos_a, twos_b);
+        csa(twos_a, ones, ones, block(4), block(5));
+        csa(twos_b, ones, ones, block(6), block(7));
+        csa(fours_b, twos, twos, twos_a, twos_b);
+        csa(eights_a, fours, fours, fours_a, fours_b);
+        csa(twos_a, ones, ones, block(8), block(9));
+        csa(twos_b, ones, ones, block(10), block(11));
+        csa(fours_a, twos, twos, twos_a, twos_b);
+        csa(twos_a, ones, ones, block(12), block(13));
+        csa(twos_b, ones, ones, block(14), block(15));
+        csa(fours_b, twos, twos, twos_a, twos_b);
+        csa(eights_b, fours, fours, fours_a, fours_b);
+        csa(sixteens, eights, eights, eights_a, eights_b);
+        count += vec_popcount(sixteens);
+    }
+    return 16 * count + 8 * vec_popcount(eights) + 4 * vec_popcount(fours) +
+           2 * vec_popcount(twos) + vec_popcount(ones);
+}
+#endif
+
+template <typename T, typename G>
+[[nodiscard]] constexpr auto generated_popcount(G const &g, std::size_t n)
+    -> std::size_t {
+    static_assert(std::is_unsigned_v<T>);
+    auto i = std::size_t{};
+    auto count = std::size_t{};
+#if STDX_SIMD_WIDTH != 0
+    if (not std::is_constant_evaluated()) {
+        count += harley_seal<T>(g, i, n);
+        // the remaining (fewer than 16) blocks accumulate in byte lanes
+        auto acc = vec_t<std::uint64_t>{};
+        for (auto const end = n - n % lanes<T>; i < end; i += lanes<T>) {
+            acc += byte_popcounts(
+                bit_cast<vec_t<std::uint64_t>>(g.template get<vec_t<T>>(i)));
+        }
+        count += sum_bytes(acc);
+    }
+#endif
+    for (; i < n; ++i) {
+        count += static_cast<std::size_t>(stdx::popcount(g.template get<T>(i)));
+    }
+    return count;
+}
+
+template <typename T> struct words {
+    T const *p;
+
+    template <typename V>
+    [[nodiscard]] constexpr auto get(std::size_t i) const -> V {
+#if STDX_SIMD_WIDTH != 0
+        if constexpr (not std::is_same_v<V, T>) {
+            return load(p + i);
+        } else
+#endif
+        {
+            return p[i];
+        }
+    }
+};
+
+template <typename T>
+[[nodiscard]] constexpr auto popcount(T const *p, std::size_t n)
+    -> std::size_t {
+    return generated_popcount<T>(words<T>{p}, n);
+}
+
+template <typename T, typename G>
+[[nodiscard]] constexpr auto generated_any(G const &g, std::size_t n) -> bool {
+    static_assert(std::is_unsigned_v<T>);
+    auto i = std::size_t{};
+#if STDX_SIMD_WIDTH != 0
+    if (not std::is_constant_evaluated()) {
+        for (auto const end = n - n % lanes<T>; i < end; i += lanes<T>) {
+            if (not is_zero<T>(g.template get<vec_t<T>>(i))) {
+                return true;
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (g.template get<T>(i) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Transposes a 64x64 bit matrix held as 64 words (bit c of word r moves to
+// bit r of word c) by swapping ever smaller off-diagonal blocks: first 32x32,
+// then 16x16, and so on. While the blocks are at least a vector wide, the
+// swaps work a vector of words at a time.
+constexpr auto transpose64(std::uint64_t *a) -> void {
+    auto m = std::uint64_t{0xffff'ffffu};
+    for (auto j = std::size_t{32}; j != 0; j >>= 1u, m ^= m << j) {
+        for (auto base = std::size_t{}; base < 64; base += 2 * j) {
+            auto k = base;
+#if STDX_SIMD_WIDTH != 0
+            if (not std::is_constant_evaluated()) {
+                for (; k + lanes<std::uint64_t> <= base + j;
+                     k += lanes<std::uint64_t>) {
+                    auto const lo = load(a + k);
+                    auto const hi = load(a + k + j);
+                    auto const t = ((lo >> j) ^ hi) & m;
+                    store(a + k + j, hi ^ t);
+                    store(a + k, lo ^ (t << j));
+                }
+            }
+#endif
+            for (; k < base + j; ++k) {
+                auto const t = ((a[k] >> j) ^ a[k + j]) & m;
+                a[k + j] ^= t;
+                a[k] ^= t << j;
+            }
+        }
+    }
+}
+
+// out[j] = (src[j + 1] << s) | (src[j] >> (digits - s)), for j in [0, n),
+// working from high to low so that it is safe in place when out > src
+template <typename T>
+constexpr auto funnel_shift_left(T *out, T const *src, std::size_t n,
+                                 std::size_t s) -> void {
+    static_assert(std::is_unsigned_v<T>);
+    auto const borrow = std::numeric_limits<T>::digits - s;
+#if STDX_SIMD_WIDTH != 0
+    if (not std::is_constant_evaluated()) {
+        for (; n >= lanes<T>; n -= lanes<T>) {
+            auto const j = n - lanes<T>;
+            auto const hi = load(src + j + 1);
+            auto const lo = load(src + j);
+            store(out + j, vec_t<T>((hi << s) | (lo >> borrow)));
+        }
+    }
+#endif
+    while (n > 0) {
+        --n;
+        out[n] = static_cast<T>(src[n + 1] << s);
+        out[n] |= static_cast<T>(src[n] >> borrow);
+    }
+}
+
+// out[j] = (src[j] >> s) | (src[j + 1] << (digits - s)), for j in [0, n),
+// working from low to high so that it is safe in place when out < src
+template <typename T>
+constexpr auto funnel_shift_right(T *out, T const *src, std::size_t n,
+                                  std::size_t s) -> void {
+    static_assert(std::is_unsigned_v<T>);
+    auto const borrow = std::numeric_limits<T>::digits - s;
+    auto j = std::size_t{};
+#if STDX_SIMD_WIDTH != 0
+    if (not std::is_constant_evaluated()) {
+        for (auto const end = n - n % lanes<T>; j < end; j += lanes<T>) {
+            auto const lo = load(src + j);
+            auto const hi = load(src + j + 1);
+            store(out + j, vec_t<T>((lo >> s) | (hi << borrow)));
+        }
+    }
+#endif
+    for (; j < n; ++j) {
+        out[j] = static_cast<T>(src[j] >> s);
+        out[j] |= static_cast<T>(src[j + 1] << borrow);
+    }
+}
+
+// Bit i of the result is set when p[i] == c, for the group_width bytes at p:
+// the control bytes of a group in an open-addressing hash table.
+constexpr inline std::size_t group_width = 16;
+
+[[nodiscard]] constexpr auto match_bytes(std::uint8_t const *p,
+                                         std::uint8_t c) -> std::uint32_t {
+    auto r = std::uint32_t{};
+#if STDX_SIMD_WIDTH != 0
+    if (not std::is_constant_evaluated()) {
+        // NOLINTNEXTLINE(modernize-use-using)
+        typedef char group_t __attribute__((vector_size(group_width)));
+        group_t v;
+        std::memcpy(&v, p, group_width);
+        auto const eq = group_t(v == static_cast<char>(c));
+#if defined(__SSE2__)
+        r = static_cast<std::uint32_t>(__builtin_ia32_pmovmskb128(eq));
+#else
+        // gather the top bit of each byte of each half into one byte
+        // NOLINTNEXTLINE(modernize-use-using)
+        typedef std::uint64_t halves_t
+            __attribute__((vector_size(group_width)));
+        auto const halves = bit_cast<halves_t>(eq);
+        for (auto h = std::size_t{}; h < 2; ++h) {
+            auto const top = halves[h] & 0x8080'8080'8080'8080u;
+            r |= static_cast<std::uint32_t>(
+                     (top * 0x0002'0408'1020'4081u) >> 56u)
+                 << (8 * h);
+        }
+#endif
+        return r;
+    }
+#endif
+    for (auto i = std::size_t{}; i < group_width; ++i) {
+        r |= static_cast<std::uint32_t>(p[i] == c) << i;
+    }
+    return r;
+}
+
+// integers and enums, which compare equal exactly when their bits are equal
+template <typename T>
+constexpr inline bool bitwise_comparable =
+    (std::is_integral_v<T> or std::is_enum_v<T>) and
+    sizeof(T) <= sizeof(std::uint64_t);
+
+// The index of the first of the n elements at p that equals value, or n if
+// none does. At runtime, bitwise-comparable elements are compared a vector at
+// a time, and the scalar loop finds the match within the first block that has
+// one.
+template <typename T>
+[[nodiscard]] constexpr auto find(T const *p, std::size_t n, T const &value)
+    -> std::size_t {
+    auto i = std::size_t{};
+#if STDX_SIMD_WIDTH != 0
+    if constexpr (bitwise_comparable<T>) {
+        if (not std::is_constant_evaluated()) {
+            using U = smallest_uint_t<bit_size<T>()>;
+            auto const v = vec_t<U>{} + bit_cast<U>(value);
+            for (auto const end = n - n % lanes<U>; i < end; i += lanes<U>) {
+                vec_t<U> block;
+                std::memcpy(&block, p + i, width);
+                if (not is_zero<U>(vec_t<U>(block == v))) {
+                    break;
+                }
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (p[i] == value) {
+            return i;
+        }
+    }
+    return n;
+}
+} // namespace detail::simd
+} // namespace v1
+} // namespace stdx
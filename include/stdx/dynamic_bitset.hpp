@@ -0,0 +1,512 @@
+#pragma once
+
+#include <stdx/bit.hpp>
+#include <stdx/compiler.hpp>
+#include <stdx/detail/bitset_common.hpp>
+#include <stdx/detail/simd.hpp>
+#include <stdx/panic.hpp>
+#include <stdx/span.hpp>
+#include <stdx/type_traits.hpp>
+#include <stdx/udls.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace stdx {
+inline namespace v1 {
+template <typename StorageElem = std::uint64_t,
+          std::size_t InlineSize = 2 * std::numeric_limits<StorageElem>::digits>
+class dynamic_bitset {
+    using elem_t = StorageElem;
+    static_assert(
+        std::is_unsigned_v<elem_t>,
+        "Storage element for dynamic_bitset must be an unsigned type");
+
+    constexpr static auto storage_elem_size =
+        std::size_t{std::numeric_limits<elem_t>::digits};
+    constexpr static auto inline_storage_size =
+        (InlineSize + storage_elem_size - 1) / storage_elem_size;
+    constexpr static auto bit = elem_t{1U};
+    constexpr static auto allbits = std::numeric_limits<elem_t>::max();
+
+    std::size_t num_bits{};
+    std::array<elem_t, inline_storage_size> small{};
+    // the words in use: small, or a heap allocation when small is too small
+    elem_t *words{std::data(small)};
+
+    [[nodiscard]] constexpr static auto words_for(std::size_t n)
+        -> std::size_t {
+        return (n + storage_elem_size - 1) / storage_elem_size;
+    }
+    [[nodiscard]] constexpr auto storage_size() const -> std::size_t {
+        return words_for(num_bits);
+    }
+
+    [[nodiscard]] constexpr auto data() -> elem_t * { return words; }
+    [[nodiscard]] constexpr auto data() const -> elem_t const * {
+        return words;
+    }
+    [[nodiscard]] constexpr auto on_heap() const -> bool {
+        return words != std::data(small);
+    }
+
+    [[nodiscard]] constexpr static auto allocate(std::size_t n) -> elem_t * {
+        auto alloc = std::allocator<elem_t>{};
+        auto *p = alloc.allocate(n);
+        for (auto i = std::size_t{}; i < n; ++i) {
+            std::construct_at(p + i);
+        }
+        return p;
+    }
+    constexpr static auto deallocate(elem_t *p, std::size_t n) -> void {
+        std::allocator<elem_t>{}.deallocate(p, n);
+    }
+
+    constexpr auto release() -> void {
+        if (on_heap()) {
+            deallocate(words, storage_size());
+            words = std::data(small);
+        }
+    }
+
+    // allocate (zeroed) storage for n bits, discarding the current contents
+    constexpr auto init(std::size_t n) -> void {
+        num_bits = n;
+        if (storage_size() > inline_storage_size) {
+            words = allocate(storage_size());
+        }
+    }
+
+    [[nodiscard]] constexpr auto lastmask() const -> elem_t {
+        if (auto const rem = num_bits % storage_elem_size; rem != 0) {
+            return static_cast<elem_t>(allbits >> (storage_elem_size - rem));
+        }
+        return allbits;
+    }
+    [[nodiscard]] constexpr auto highbits() const -> elem_t {
+        return static_cast<elem_t>(data()[storage_size() - 1] & lastmask());
+    }
+
+    // the binary operations combine bitsets of the same size only
+    [[nodiscard]] constexpr auto same_size(dynamic_bitset const &rhs) const
+        -> bool {
+        if (num_bits != rhs.num_bits) {
+            STDX_PANIC("dynamic_bitset sizes differ!");
+            return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]] constexpr static auto indices(std::size_t pos) {
+        struct locator {
+            std::size_t index;
+            std::size_t offset;
+        };
+        return locator{pos / storage_elem_size, pos % storage_elem_size};
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(dynamic_bitset const &lhs,
+                                                   dynamic_bitset const &rhs)
+        -> bool {
+        if (lhs.num_bits != rhs.num_bits) {
+            return false;
+        }
+        if (lhs.num_bits == 0) {
+            return true;
+        }
+        return detail::simd::equal(lhs.data(), rhs.data(),
+                                   lhs.storage_size() - 1) and
+               lhs.highbits() == rhs.highbits();
+    }
+
+    friend constexpr auto operator|(dynamic_bitset lhs,
+                                    dynamic_bitset const &rhs)
+        -> dynamic_bitset {
+        lhs |= rhs;
+        return lhs;
+    }
+
+    friend constexpr auto operator&(dynamic_bitset lhs,
+                                    dynamic_bitset const &rhs)
+        -> dynamic_bitset {
+        lhs &= rhs;
+        return lhs;
+    }
+
+    friend constexpr auto operator^(dynamic_bitset lhs,
+                                    dynamic_bitset const &rhs)
+        -> dynamic_bitset {
+        lhs ^= rhs;
+        return lhs;
+    }
+
+    friend constexpr auto operator-(dynamic_bitset const &lhs,
+                                    dynamic_bitset rhs) -> dynamic_bitset {
+        rhs.flip();
+        return lhs & rhs;
+    }
+
+    friend constexpr auto operator<<(dynamic_bitset lhs, std::size_t pos)
+        -> dynamic_bitset {
+        lhs <<= pos;
+        return lhs;
+    }
+    friend constexpr auto operator>>(dynamic_bitset lhs, std::size_t pos)
+        -> dynamic_bitset {
+        lhs >>= pos;
+        return lhs;
+    }
+
+    template <detail::bit_spec Spec, typename F>
+    constexpr auto for_each(F &&f) const -> F {
+        if (num_bits == 0) {
+            return std::forward<F>(f);
+        }
+        auto const *storage = data();
+        auto const last = storage_size() - 1;
+        std::size_t idx = 0;
+        for (auto i = std::size_t{}; i < last; ++i) {
+            Spec::template fn<bit, std::size_t, allbits>(storage[i], idx, f);
+            idx += storage_elem_size;
+        }
+        if constexpr (std::is_same_v<Spec, unset_bit>) {
+            Spec::template fn<bit, std::size_t, allbits>(
+                static_cast<elem_t>(storage[last] | ~lastmask()), idx, f);
+        } else if constexpr (std::is_same_v<Spec, set_bit>) {
+            Spec::template fn<bit, std::size_t, allbits>(highbits(), idx, f);
+        } else {
+            auto const n = num_bits;
+            auto g = [&](std::size_t i, bool b) {
+                if (i < n) {
+                    f(i, b);
+                }
+            };
+            Spec::template fn<bit, std::size_t, allbits>(highbits(), idx, g);
+        }
+        return std::forward<F>(f);
+    }
+
+    template <detail::bit_spec Spec, typename F, typename S, std::size_t I>
+    friend constexpr auto for_each(F &&f, dynamic_bitset<S, I> const &bs)
+        -> F;
+
+    template <typename T, typename F, typename R>
+    constexpr auto transform_reduce(F &&f, R &&r, T init) const -> T {
+        if (num_bits == 0) {
+            return init;
+        }
+        return detail::bitset_words::transform_reduce<std::size_t>(
+            data(), storage_size(), lastmask(), f, r, std::move(init));
+    }
+
+    template <typename T, typename F, typename R, typename S, std::size_t I>
+    friend constexpr auto transform_reduce(F &&f, R &&r, T init,
+                                           dynamic_bitset<S, I> const &bs)
+        -> T;
+
+  public:
+    constexpr dynamic_bitset() = default;
+    constexpr explicit dynamic_bitset(std::size_t size) { init(size); }
+
+    constexpr explicit dynamic_bitset(std::size_t size, std::uint64_t value) {
+        init(size);
+        for (auto *p = data(); p != data() + storage_size(); ++p) {
+            if (value == 0) {
+                break;
+            }
+            *p = static_cast<elem_t>(value & allbits);
+            if constexpr (storage_elem_size < 64) {
+                value >>= storage_elem_size;
+            } else {
+                value = 0;
+            }
+        }
+    }
+
+    template <typename... Bs>
+    constexpr explicit dynamic_bitset(std::size_t size, place_bits_t,
+                                      Bs... bs) {
+        static_assert(((std::is_integral_v<Bs> or std::is_enum_v<Bs>) and ...),
+                      "Bit places must be integral or enumeration types!");
+        init(size);
+        (set(static_cast<std::size_t>(bs)), ...);
+    }
+
+    constexpr explicit dynamic_bitset(std::size_t size, all_bits_t) {
+        init(size);
+        set();
+    }
+
+    constexpr explicit dynamic_bitset(std::string_view str, std::size_t pos = 0,
+                                      std::size_t n = std::string_view::npos,
+                                      char one = '1') {
+        auto const s = str.substr(pos, std::min(n, str.size() - pos));
+        init(s.size());
+        auto i = std::size_t{};
+        // NOLINTNEXTLINE(modernize-loop-convert)
+        for (auto it = std::rbegin(s); it != std::rend(s); ++it) {
+            set(i++, *it == one);
+        }
+    }
+
+    constexpr dynamic_bitset(dynamic_bitset const &rhs) {
+        init(rhs.num_bits);
+        std::copy_n(rhs.data(), storage_size(), data());
+    }
+    constexpr dynamic_bitset(dynamic_bitset &&rhs) noexcept
+        : num_bits{rhs.num_bits}, small{rhs.small} {
+        if (rhs.on_heap()) {
+            words = std::exchange(rhs.words, std::data(rhs.small));
+        }
+        rhs.num_bits = 0;
+    }
+
+    constexpr auto operator=(dynamic_bitset const &rhs) -> dynamic_bitset & {
+        if (this != &rhs) {
+            if (storage_size() != rhs.storage_size()) {
+                release();
+                init(rhs.num_bits);
+            }
+            num_bits = rhs.num_bits;
+            std::copy_n(rhs.data(), storage_size(), data());
+        }
+        return *this;
+    }
+    constexpr auto operator=(dynamic_bitset &&rhs) noexcept
+        -> dynamic_bitset & {
+        if (this != &rhs) {
+            release();
+            num_bits = std::exchange(rhs.num_bits, 0);
+            small = rhs.small;
+            if (rhs.on_heap()) {
+                words = std::exchange(rhs.words, std::data(rhs.small));
+            }
+        }
+        return *this;
+    }
+
+    constexpr ~dynamic_bitset() { release(); }
+
+    constexpr static std::integral_constant<std::size_t,
+                                            inline_storage_size *
+                                                storage_elem_size>
+        inline_capacity{};
+
+    [[nodiscard]] constexpr auto capacity() const -> std::size_t {
+        return num_bits;
+    }
+
+    constexpr auto resize(std::size_t size) -> void {
+        auto const old_words = storage_size();
+        auto const new_words = words_for(size);
+        if (num_bits != 0) {
+            data()[old_words - 1] &= lastmask();
+        }
+        if (new_words > inline_storage_size) {
+            if (new_words != old_words) {
+                auto *p = allocate(new_words);
+                std::copy_n(data(), std::min(old_words, new_words), p);
+                release();
+                words = p;
+            }
+        } else {
+            if (on_heap()) {
+                std::copy_n(words, new_words, std::data(small));
+                release();
+            }
+            for (auto i = old_words; i < new_words; ++i) {
+                small[i] = 0;
+            }
+        }
+        num_bits = size;
+    }
+
+    [[nodiscard]] constexpr auto operator[](std::size_t pos) const -> bool {
+        auto const [index, offset] = indices(pos);
+        return (data()[index] & (bit << offset)) != 0;
+    }
+
+    constexpr auto set(std::size_t pos, bool value = true) LIFETIMEBOUND
+        -> dynamic_bitset & {
+        auto const [index, offset] = indices(pos);
+        if (value) {
+            data()[index] |= static_cast<elem_t>(bit << offset);
+        } else {
+            data()[index] &= static_cast<elem_t>(~(bit << offset));
+        }
+        return *this;
+    }
+
+    constexpr auto set(lsb_t lsb, msb_t msb, bool value = true) LIFETIMEBOUND
+        -> dynamic_bitset & {
+        detail::bitset_words::set_range(data(), to_underlying(lsb),
+                                        to_underlying(msb), value);
+        return *this;
+    }
+
+    constexpr auto set(lsb_t lsb, length_t len, bool value = true) LIFETIMEBOUND
+        -> dynamic_bitset & {
+        auto const l = to_underlying(lsb);
+        auto const length = to_underlying(len);
+        return set(lsb, static_cast<msb_t>(l + length - 1), value);
+    }
+
+    constexpr auto set() LIFETIMEBOUND -> dynamic_bitset & {
+        std::fill_n(data(), storage_size(), allbits);
+        return *this;
+    }
+
+    constexpr auto reset(std::size_t pos) LIFETIMEBOUND -> dynamic_bitset & {
+        auto const [index, offset] = indices(pos);
+        data()[index] &= static_cast<elem_t>(~(bit << offset));
+        return *this;
+    }
+
+    constexpr auto reset() LIFETIMEBOUND -> dynamic_bitset & {
+        std::fill_n(data(), storage_size(), elem_t{});
+        return *this;
+    }
+
+    constexpr auto reset(lsb_t lsb, msb_t msb) LIFETIMEBOUND
+        -> dynamic_bitset & {
+        return set(lsb, msb, false);
+    }
+
+    constexpr auto reset(lsb_t lsb, length_t len) LIFETIMEBOUND
+        -> dynamic_bitset & {
+        return set(lsb, len, false);
+    }
+
+    template <typename... Ts>
+    constexpr auto clear(Ts... ts) LIFETIMEBOUND -> dynamic_bitset & {
+        return reset(ts...);
+    }
+
+    constexpr auto flip(std::size_t pos) LIFETIMEBOUND -> dynamic_bitset & {
+        auto const [index, offset] = indices(pos);
+        data()[index] ^= static_cast<elem_t>(bit << offset);
+        return *this;
+    }
+
+    constexpr auto flip() LIFETIMEBOUND -> dynamic_bitset & {
+        detail::simd::transform(data(), storage_size(), std::bit_not{});
+        return *this;
+    }
+
+    [[nodiscard]] constexpr auto count() const -> std::size_t {
+        if (num_bits == 0) {
+            return {};
+        }
+        return static_cast<std::size_t>(popcount(highbits())) +
+               detail::simd::popcount(data(), storage_size() - 1);
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t { return count(); }
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        return size() == std::size_t{};
+    }
+
+    [[nodiscard]] constexpr auto all() const -> bool {
+        return count() == capacity();
+    }
+
+    [[nodiscard]] constexpr auto any() const -> bool {
+        return count() != std::size_t{};
+    }
+
+    [[nodiscard]] constexpr auto none() const -> bool { return empty(); }
+
+    [[nodiscard]] constexpr auto lowest_unset() const -> std::size_t {
+        return std::min(detail::bitset_words::lowest_unset<std::size_t>(
+                            data(), storage_size()),
+                        num_bits);
+    }
+
+    // Writes the indices of set bits (from pos upwards) to out, stopping when
+    // out is full, and returns the number written. To decode in batches,
+    // resume from one past the last index written.
+    template <typename T, std::size_t Extent>
+    [[nodiscard]] constexpr auto decode_set_bits(span<T, Extent> out,
+                                                 std::size_t pos = 0) const
+        -> std::size_t {
+        static_assert(std::is_unsigned_v<T>, "Index type must be unsigned");
+        if (num_bits == 0) {
+            return {};
+        }
+        return detail::bitset_words::decode(data(), storage_size(), lastmask(),
+                                            pos, std::data(out),
+                                            std::size(out));
+    }
+
+    [[nodiscard]] constexpr auto operator~() const -> dynamic_bitset {
+        dynamic_bitset result{*this};
+        result.flip();
+        return result;
+    }
+
+    constexpr auto operator|=(dynamic_bitset const &rhs)
+        LIFETIMEBOUND->dynamic_bitset & {
+        if (same_size(rhs)) {
+            detail::simd::transform(data(), rhs.data(), storage_size(),
+                                    std::bit_or{});
+        }
+        return *this;
+    }
+    constexpr auto operator&=(dynamic_bitset const &rhs)
+        LIFETIMEBOUND->dynamic_bitset & {
+        if (same_size(rhs)) {
+            detail::simd::transform(data(), rhs.data(), storage_size(),
+                                    std::bit_and{});
+        }
+        return *this;
+    }
+    constexpr auto operator^=(dynamic_bitset const &rhs)
+        LIFETIMEBOUND->dynamic_bitset & {
+        if (same_size(rhs)) {
+            detail::simd::transform(data(), rhs.data(), storage_size(),
+                                    std::bit_xor{});
+        }
+        return *this;
+    }
+
+    constexpr auto operator<<=(std::size_t pos)
+        LIFETIMEBOUND->dynamic_bitset & {
+        if (num_bits != 0) {
+            detail::bitset_words::shift_left(data(), storage_size(), pos);
+        }
+        return *this;
+    }
+
+    constexpr auto operator>>=(std::size_t pos)
+        LIFETIMEBOUND->dynamic_bitset & {
+        if (num_bits != 0) {
+            data()[storage_size() - 1] &= lastmask();
+            detail::bitset_words::shift_right(data(), storage_size(), pos);
+        }
+        return *this;
+    }
+};
+
+template <detail::bit_spec Spec = set_bit, typename F, typename S,
+          std::size_t I>
+constexpr auto for_each(F &&f, dynamic_bitset<S, I> const &bs) -> F {
+    return bs.template for_each<Spec>(std::forward<F>(f));
+}
+
+template <typename T, typename F, typename R, typename S, std::size_t I>
+[[nodiscard]] constexpr auto transform_reduce(F &&f, R &&r, T init,
+                                              dynamic_bitset<S, I> const &bs)
+    -> T {
+    return bs.transform_reduce(std::forward<F>(f), std::forward<R>(r),
+                               std::move(init));
+}
+} // namespace v1
+} // namespace stdx
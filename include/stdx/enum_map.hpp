@@ -0,0 +1,112 @@
+#pragma once
+
+#include <stdx/compiler.hpp>
+#include <stdx/enum_set.hpp>
+#include <stdx/iterator.hpp>
+#include <stdx/type_traits.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace stdx {
+inline namespace v1 {
+// A map keyed by an enumeration whose enumerators run densely from 0 to Max
+// (exclusive). Values live in an array indexed by the key, and an enum_set
+// records which are present, so lookup, insertion and erasure are O(1).
+template <typename E, typename V, E Max = E::MAX> class enum_map {
+    constexpr static auto N = static_cast<std::size_t>(to_underlying(Max));
+
+    enum_set<E, Max> present{};
+    std::array<V, N> storage{};
+
+    [[nodiscard]] constexpr static auto index(E key) -> std::size_t {
+        return static_cast<std::size_t>(to_underlying(key));
+    }
+
+  public:
+    using key_type = E;
+    using mapped_type = V;
+    using size_type = std::size_t;
+
+    [[nodiscard]] constexpr auto size() const -> size_type {
+        return present.size();
+    }
+    constexpr static std::integral_constant<size_type, N> capacity{};
+
+    [[nodiscard]] constexpr auto full() const -> bool { return present.full(); }
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        return present.empty();
+    }
+
+    constexpr auto clear() -> void {
+        present.for_each([&](auto key) { storage[index(key)] = V{}; });
+        present.clear();
+    }
+
+    // precondition: contains(key)
+    [[nodiscard]] constexpr auto get(key_type key) LIFETIMEBOUND
+        -> mapped_type & {
+        return storage[index(key)];
+    }
+    [[nodiscard]] constexpr auto get(key_type key) const LIFETIMEBOUND
+        -> mapped_type const & {
+        return storage[index(key)];
+    }
+
+    [[nodiscard]] constexpr auto contains(key_type key) const -> bool {
+        return present.contains(key);
+    }
+
+    constexpr auto insert_or_assign(key_type key, mapped_type const &value)
+        -> bool {
+        storage[index(key)] = value;
+        return present.insert(key);
+    }
+    constexpr auto put(key_type key, mapped_type const &value) -> bool {
+        return insert_or_assign(key, value);
+    }
+
+    constexpr auto erase(key_type key) -> size_type {
+        if (present.erase(key) == 0) {
+            return 0u;
+        }
+        storage[index(key)] = V{};
+        return 1u;
+    }
+
+    // calls f(key, value) for each key present, in enumerator order
+    template <typename F> constexpr auto for_each(F &&f) -> F {
+        present.for_each([&](auto key) { f(key, storage[index(key)]); });
+        return std::forward<F>(f);
+    }
+    template <typename F> constexpr auto for_each(F &&f) const -> F {
+        present.for_each([&](auto key) { f(key, storage[index(key)]); });
+        return std::forward<F>(f);
+    }
+
+    [[nodiscard]] constexpr auto keys() const LIFETIMEBOUND
+        -> enum_set<E, Max> const & {
+        return present;
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(enum_map const &lhs,
+                                                   enum_map const &rhs)
+        -> bool {
+        if (lhs.present != rhs.present) {
+            return false;
+        }
+        auto equal = true;
+        lhs.for_each([&](auto key, auto const &value) {
+            equal = equal and value == rhs.get(key);
+        });
+        return equal;
+    }
+};
+
+template <typename E, typename V, E Max>
+constexpr auto ct_capacity_v<enum_map<E, V, Max>> =
+    static_cast<std::size_t>(to_underlying(Max));
+} // namespace v1
+} // namespace stdx
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdx/bitset.hpp>
+#include <stdx/compiler.hpp>
+#include <stdx/concepts.hpp>
+#include <stdx/iterator.hpp>
+#include <stdx/type_traits.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace stdx {
+inline namespace v1 {
+// A set of the values of an enumeration whose enumerators run densely from 0
+// to Max (exclusive), held as a bitset.
+template <typename E, E Max = E::MAX> class enum_set {
+    static_assert(std::is_enum_v<E>, "enum_set requires an enumeration type");
+
+    bitset<Max> storage{};
+
+  public:
+    using key_type = E;
+    using value_type = E;
+    using size_type = std::size_t;
+
+    constexpr enum_set() = default;
+    template <same_as<E>... Es>
+    constexpr explicit enum_set(Es... es) : storage{place_bits, es...} {}
+
+    [[nodiscard]] constexpr auto size() const -> size_type {
+        return storage.count();
+    }
+    constexpr static std::integral_constant<size_type, to_underlying(Max)>
+        capacity{};
+
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        return storage.none();
+    }
+    [[nodiscard]] constexpr auto full() const -> bool { return storage.all(); }
+
+    constexpr auto clear() -> void { storage.reset(); }
+
+    [[nodiscard]] constexpr auto contains(key_type key) const -> bool {
+        return storage[key];
+    }
+
+    // returns true if key was inserted, false if it was already present
+    constexpr auto insert(key_type key) -> bool {
+        if (storage[key]) {
+            return false;
+        }
+        storage.set(key);
+        return true;
+    }
+
+    constexpr auto erase(key_type key) -> size_type {
+        if (not storage[key]) {
+            return 0u;
+        }
+        storage.reset(key);
+        return 1u;
+    }
+
+    // calls f with each key present, in enumerator order
+    template <typename F> constexpr auto for_each(F &&f) const -> F {
+        return stdx::for_each(std::forward<F>(f), storage);
+    }
+
+    [[nodiscard]] constexpr auto bits() const LIFETIMEBOUND
+        -> bitset<Max> const & {
+        return storage;
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(enum_set const &,
+                                                   enum_set const &)
+        -> bool = default;
+};
+
+template <typename E, same_as<E>... Es> enum_set(E, Es...) -> enum_set<E>;
+
+template <typename E, E Max>
+constexpr auto ct_capacity_v<enum_set<E, Max>> =
+    static_cast<std::size_t>(to_underlying(Max));
+} // namespace v1
+} // namespace stdx
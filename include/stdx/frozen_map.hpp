@@ -0,0 +1,234 @@
+#pragma once
+
+#include <stdx/compiler.hpp>
+#include <stdx/cx_map.hpp>
+#include <stdx/hash.hpp>
+#include <stdx/iterator.hpp>
+#include <stdx/utility.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace stdx {
+inline namespace v1 {
+namespace detail::frozen {
+constexpr inline auto keys_per_bucket = std::size_t{1};
+
+// a displacement with this bit set is the slot itself
+constexpr inline auto direct = std::uint32_t{1} << 31u;
+
+template <std::size_t N>
+constexpr inline auto num_buckets = N / keys_per_bucket + 1;
+
+// maps the low 32 bits of x onto [0, n) without a division
+[[nodiscard]] constexpr auto reduce(std::uint64_t x, std::size_t n)
+    -> std::size_t {
+    return ((x & 0xffff'ffffu) * n) >> 32u;
+}
+
+[[nodiscard]] constexpr auto bucket_of(std::uint64_t h, std::size_t n)
+    -> std::size_t {
+    return reduce(h >> 32u, n);
+}
+
+[[nodiscard]] constexpr auto slot_of(std::uint64_t h, std::uint32_t d,
+                                     std::size_t n) -> std::size_t {
+    return reduce(cx_hash::mix(h + d * 0x9e37'79b9'7f4a'7c15u), n);
+}
+
+// these are not constexpr: reaching one stops compilation with its name in
+// the error
+inline auto keys_must_be_distinct() -> void {}
+inline auto perfect_hash_not_found() -> void {}
+
+template <std::size_t N> struct table {
+    std::array<std::uint32_t, num_buckets<N>> displacements{};
+    // key_of_slot[s] is the index (in the input) of the key in slot s
+    std::array<std::size_t, N> key_of_slot{};
+};
+
+// CHD (hash, displace and compress): the keys are grouped into buckets of
+// about 1 by their hash. Then the buckets of several keys, largest first, each
+// take the first displacement that sends all their keys to free slots. Buckets
+// of one key take the remaining slots directly. There are N slots, so the
+// result is a minimal perfect hash.
+template <std::size_t N>
+consteval auto build(std::array<std::uint64_t, N> const &hashes) -> table<N> {
+    static_assert(N < direct, "frozen containers are limited to 2^31 keys");
+    constexpr auto buckets = num_buckets<N>;
+    constexpr auto max_displacement = 64 * N + 1024;
+
+    // the keys of bucket b are members[start[b]] to members[start[b + 1]]
+    std::array<std::size_t, buckets + 1> start{};
+    for (auto h : hashes) {
+        ++start[bucket_of(h, buckets) + 1];
+    }
+    auto largest = std::size_t{};
+    for (auto b = std::size_t{}; b < buckets; ++b) {
+        largest = std::max(largest, start[b + 1]);
+        start[b + 1] += start[b];
+    }
+    std::array<std::size_t, N> members{};
+    auto fill = start;
+    for (auto i = std::size_t{}; i < N; ++i) {
+        members[fill[bucket_of(hashes[i], buckets)]++] = i;
+    }
+
+    table<N> t{};
+    std::array<bool, N> taken{};
+    std::array<std::size_t, N> slots{};
+    for (auto size = largest; size > 1; --size) {
+        for (auto b = std::size_t{}; b < buckets; ++b) {
+            if (start[b + 1] - start[b] != size) {
+                continue;
+            }
+            auto const *keys = std::data(members) + start[b];
+            for (auto d = std::uint32_t{};; ++d) {
+                if (d == max_displacement) {
+                    perfect_hash_not_found();
+                }
+                auto fits = true;
+                for (auto k = std::size_t{}; fits and k < size; ++k) {
+                    slots[k] = slot_of(hashes[keys[k]], d, N);
+                    fits = not taken[slots[k]];
+                    for (auto j = std::size_t{}; fits and j < k; ++j) {
+                        if (hashes[keys[j]] == hashes[keys[k]]) {
+                            keys_must_be_distinct();
+                        }
+                        fits = slots[j] != slots[k];
+                    }
+                }
+                if (fits) {
+                    t.displacements[b] = d;
+                    for (auto k = std::size_t{}; k < size; ++k) {
+                        taken[slots[k]] = true;
+                        t.key_of_slot[slots[k]] = keys[k];
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    auto free_slot = std::size_t{};
+    for (auto b = std::size_t{}; b < buckets; ++b) {
+        if (start[b + 1] - start[b] == 1) {
+            while (taken[free_slot]) {
+                ++free_slot;
+            }
+            taken[free_slot] = true;
+            t.displacements[b] = static_cast<std::uint32_t>(free_slot) | direct;
+            t.key_of_slot[free_slot] = members[start[b]];
+        }
+    }
+    return t;
+}
+
+template <std::size_t N, typename Hash, typename K>
+[[nodiscard]] constexpr auto
+lookup(Hash const &hash,
+       std::array<std::uint32_t, num_buckets<N>> const &displacements,
+       K const &key) -> std::size_t {
+    auto const h = hash(key);
+    auto const d = displacements[bucket_of(h, num_buckets<N>)];
+    return (d & direct) != 0 ? d ^ direct : slot_of(h, d, N);
+}
+} // namespace detail::frozen
+
+// A read-only map whose entries are fixed at compile time. A perfect hash is
+// found at compile time, so a lookup is one hash and one key comparison.
+template <typename Key, typename Value, std::size_t N, typename Hash = cx_hash>
+class frozen_map {
+  public:
+    using value_type = cx_map_value<Key, Value>;
+    using key_type = typename value_type::key_type;
+    using mapped_type = typename value_type::mapped_type;
+    using size_type = std::size_t;
+    using const_reference = value_type const &;
+    using const_iterator = value_type const *;
+    using iterator = const_iterator;
+
+  private:
+    std::array<value_type, N> storage{};
+    std::array<std::uint32_t, detail::frozen::num_buckets<N>> displacements{};
+    [[no_unique_address]] Hash hash{};
+
+    [[nodiscard]] constexpr auto slot(key_type const &key) const
+        -> std::size_t {
+        return detail::frozen::lookup<N>(hash, displacements, key);
+    }
+
+  public:
+    consteval explicit frozen_map(std::array<value_type, N> const &entries,
+                                  Hash h = {})
+        : hash{std::move(h)} {
+        std::array<std::uint64_t, N> hashes{};
+        for (auto i = std::size_t{}; i < N; ++i) {
+            hashes[i] = hash(entries[i].key);
+        }
+        auto const t = detail::frozen::build(hashes);
+        displacements = t.displacements;
+        for (auto s = std::size_t{}; s < N; ++s) {
+            storage[s] = entries[t.key_of_slot[s]];
+        }
+    }
+
+    [[nodiscard]] constexpr auto begin() const LIFETIMEBOUND -> const_iterator {
+        return std::data(storage);
+    }
+    [[nodiscard]] constexpr auto cbegin() const LIFETIMEBOUND
+        -> const_iterator {
+        return std::data(storage);
+    }
+    [[nodiscard]] constexpr auto end() const LIFETIMEBOUND -> const_iterator {
+        return begin() + N;
+    }
+    [[nodiscard]] constexpr auto cend() const LIFETIMEBOUND -> const_iterator {
+        return cbegin() + N;
+    }
+
+    [[nodiscard]] constexpr static auto size() -> std::size_t { return N; }
+    constexpr static std::integral_constant<size_type, N> capacity{};
+    [[nodiscard]] constexpr static auto empty() -> bool { return N == 0; }
+
+    [[nodiscard]] constexpr auto find(key_type const &key) const LIFETIMEBOUND
+        -> const_iterator {
+        if constexpr (N == 0) {
+            return end();
+        } else {
+            auto const s = slot(key);
+            return storage[s].key == key ? begin() + s : end();
+        }
+    }
+
+    [[nodiscard]] constexpr auto contains(key_type const &key) const -> bool {
+        return find(key) != end();
+    }
+
+    [[nodiscard]] constexpr auto get(key_type const &key) const LIFETIMEBOUND
+        -> mapped_type const & {
+        if (auto const it = find(key); it != end()) {
+            return it->value;
+        }
+        unreachable();
+    }
+};
+
+template <typename K, typename V, std::size_t N>
+frozen_map(std::array<cx_map_value<K, V>, N>) -> frozen_map<K, V, N>;
+
+template <typename K, typename V, std::size_t N, typename H>
+constexpr auto ct_capacity_v<frozen_map<K, V, N, H>> = N;
+
+template <typename K, typename V, typename Hash = cx_hash, std::size_t N>
+[[nodiscard]] consteval auto
+make_frozen_map(cx_map_value<K, V> const (&entries)[N], Hash h = {})
+    -> frozen_map<K, V, N, Hash> {
+    return frozen_map<K, V, N, Hash>{std::to_array(entries), std::move(h)};
+}
+} // namespace v1
+} // namespace stdx
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdx/compiler.hpp>
+#include <stdx/frozen_map.hpp>
+#include <stdx/hash.hpp>
+#include <stdx/iterator.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace stdx {
+inline namespace v1 {
+// A read-only set whose keys are fixed at compile time, with the same perfect
+// hash as frozen_map.
+template <typename Key, std::size_t N, typename Hash = cx_hash>
+class frozen_set {
+    std::array<Key, N> storage{};
+    std::array<std::uint32_t, detail::frozen::num_buckets<N>> displacements{};
+    [[no_unique_address]] Hash hash{};
+
+  public:
+    using key_type = Key;
+    using value_type = Key;
+    using size_type = std::size_t;
+    using const_reference = value_type const &;
+    using const_iterator = value_type const *;
+    using iterator = const_iterator;
+
+    consteval explicit frozen_set(std::array<key_type, N> const &keys,
+                                  Hash h = {})
+        : hash{std::move(h)} {
+        std::array<std::uint64_t, N> hashes{};
+        for (auto i = std::size_t{}; i < N; ++i) {
+            hashes[i] = hash(keys[i]);
+        }
+        auto const t = detail::frozen::build(hashes);
+        displacements = t.displacements;
+        for (auto s = std::size_t{}; s < N; ++s) {
+            storage[s] = keys[t.key_of_slot[s]];
+        }
+    }
+
+    [[nodiscard]] constexpr auto begin() const LIFETIMEBOUND -> const_iterator {
+        return std::data(storage);
+    }
+    [[nodiscard]] constexpr auto cbegin() const LIFETIMEBOUND
+        -> const_iterator {
+        return std::data(storage);
+    }
+    [[nodiscard]] constexpr auto end() const LIFETIMEBOUND -> const_iterator {
+        return begin() + N;
+    }
+    [[nodiscard]] constexpr auto cend() const LIFETIMEBOUND -> const_iterator {
+        return cbegin() + N;
+    }
+
+    [[nodiscard]] constexpr static auto size() -> size_type { return N; }
+    constexpr static std::integral_constant<size_type, N> capacity{};
+    [[nodiscard]] constexpr static auto empty() -> bool { return N == 0; }
+
+    [[nodiscard]] constexpr auto contains(key_type const &key) const -> bool {
+        if constexpr (N == 0) {
+            return false;
+        } else {
+            return storage[detail::frozen::lookup<N>(hash, displacements,
+                                                     key)] == key;
+        }
+    }
+};
+
+template <typename K, std::size_t N>
+frozen_set(std::array<K, N>) -> frozen_set<K, N>;
+
+template <typename K, std::size_t N, typename H>
+constexpr auto ct_capacity_v<frozen_set<K, N, H>> = N;
+
+template <typename K, typename Hash = cx_hash, std::size_t N>
+[[nodiscard]] consteval auto make_frozen_set(K const (&keys)[N], Hash h = {})
+    -> frozen_set<K, N, Hash> {
+    return frozen_set<K, N, Hash>{std::to_array(keys), std::move(h)};
+}
+} // namespace v1
+} // namespace stdx
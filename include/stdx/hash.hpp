@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdx/type_traits.hpp>
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace stdx {
+inline namespace v1 {
+// A constexpr 64-bit hash: a mix of integral and enum keys, and FNV-1a (then
+// mixed) for anything convertible to string_view (including ct_string).
+struct cx_hash {
+    [[nodiscard]] constexpr static auto mix(std::uint64_t k) -> std::uint64_t {
+        k ^= k >> 33u;
+        k *= 0xff51'afd7'ed55'8ccdu;
+        k ^= k >> 33u;
+        k *= 0xc4ce'b9fe'1a85'ec53u;
+        k ^= k >> 33u;
+        return k;
+    }
+
+    template <typename K>
+    [[nodiscard]] constexpr auto operator()(K const &key) const
+        -> std::uint64_t {
+        if constexpr (std::is_integral_v<K> or std::is_enum_v<K>) {
+            return mix(static_cast<std::uint64_t>(to_underlying(key)));
+        } else if constexpr (std::is_constructible_v<std::string_view,
+                                                     K const &>) {
+            auto h = std::uint64_t{0xcbf2'9ce4'8422'2325u};
+            for (auto c : std::string_view{key}) {
+                h ^= static_cast<unsigned char>(c);
+                h *= 0x0000'0100'0000'01b3u;
+            }
+            return mix(h);
+        } else {
+            static_assert(always_false_v<K>,
+                          "cx_hash supports integral, enum and string keys: "
+                          "provide a hash function for other types");
+            return {};
+        }
+    }
+};
+} // namespace v1
+} // namespace stdx
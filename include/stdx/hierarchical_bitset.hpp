@@ -0,0 +1,401 @@
+#pragma once
+
+#include <stdx/bit.hpp>
+#include <stdx/bitset.hpp>
+#include <stdx/compiler.hpp>
+#include <stdx/detail/bitset_common.hpp>
+#include <stdx/detail/simd.hpp>
+#include <stdx/type_traits.hpp>
+#include <stdx/udls.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace stdx {
+inline namespace v1 {
+namespace detail {
+// The layout of a hierarchy of summary words over N bits. Level 0 is the bits
+// themselves; each word at level k+1 has one bit per word at level k. The top
+// level is a single word.
+template <std::size_t N> struct summary_layout {
+    constexpr static auto digits = std::size_t{64};
+
+    constexpr static auto words_at = [](std::size_t level) {
+        auto n = (N + digits - 1) / digits;
+        while (level-- > 0) {
+            n = (n + digits - 1) / digits;
+        }
+        return n;
+    };
+
+    constexpr static auto num_levels = [] {
+        auto levels = std::size_t{1};
+        while (words_at(levels - 1) > 1) {
+            ++levels;
+        }
+        return levels;
+    }();
+
+    // offsets of each summary level (1..num_levels-1) within one array
+    constexpr static auto offsets = [] {
+        auto r = std::array<std::size_t, num_levels + 1>{};
+        for (auto level = std::size_t{1}; level < num_levels; ++level) {
+            r[level + 1] = r[level] + words_at(level);
+        }
+        return r;
+    }();
+
+    constexpr static auto summary_size = offsets[num_levels];
+};
+} // namespace detail
+
+template <auto Size> class hierarchical_bitset {
+    constexpr static std::size_t N = to_underlying(Size);
+    using elem_t = std::uint64_t;
+    using layout = detail::summary_layout<N>;
+
+    constexpr static auto storage_elem_size = layout::digits;
+    constexpr static auto storage_size = layout::words_at(0);
+    constexpr static auto num_levels = layout::num_levels;
+    constexpr static auto bit = elem_t{1U};
+    constexpr static auto allbits = std::numeric_limits<elem_t>::max();
+
+    constexpr static auto lastmask = []() -> elem_t {
+        if constexpr (N % storage_elem_size != 0) {
+            return allbits >> (storage_elem_size - (N % storage_elem_size));
+        } else {
+            return allbits;
+        }
+    }();
+
+    // the bits themselves
+    std::array<elem_t, storage_size> storage{};
+    // one bit per non-empty word at the level below
+    std::array<elem_t, layout::summary_size> nonempty{};
+    // one bit per non-full word at the level below
+    std::array<elem_t, layout::summary_size> nonfull{};
+
+    using iter_arg_t = conditional_t<std::is_enum_v<decltype(Size)>,
+                                     decltype(Size), std::size_t>;
+
+    template <typename T> consteval static auto admissible_enum() {
+        return not std::is_enum_v<T> or std::is_same_v<T, decltype(Size)>;
+    }
+
+    [[nodiscard]] constexpr static auto salient(std::size_t word) -> elem_t {
+        return word == storage_size - 1 ? lastmask : allbits;
+    }
+
+    [[nodiscard]] constexpr auto summary(elem_t const *s, std::size_t level,
+                                         std::size_t idx) const -> elem_t {
+        return s[layout::offsets[level] + idx];
+    }
+
+    // the word at (level, idx) of the hierarchy selected by the Spec: for
+    // set_bit, a set bit means "look here for set bits"; for unset_bit, a set
+    // bit means "look here for unset bits"
+    template <typename Spec>
+    [[nodiscard]] constexpr auto candidates(std::size_t level,
+                                            std::size_t idx) const -> elem_t {
+        if constexpr (std::is_same_v<Spec, set_bit>) {
+            if (level == 0) {
+                return storage[idx] & salient(idx);
+            }
+            return summary(std::data(nonempty), level, idx);
+        } else {
+            if (level == 0) {
+                return static_cast<elem_t>(~storage[idx]) & salient(idx);
+            }
+            return summary(std::data(nonfull), level, idx);
+        }
+    }
+
+    template <typename Spec>
+    [[nodiscard]] constexpr auto find_lowest() const -> std::size_t {
+        if constexpr (N == 0) {
+            return N;
+        }
+        auto idx = std::size_t{};
+        for (auto level = num_levels; level-- > 0;) {
+            auto const c = candidates<Spec>(level, idx);
+            if (c == 0) {
+                return N;
+            }
+            idx = idx * storage_elem_size +
+                  static_cast<std::size_t>(countr_zero(c));
+        }
+        return idx;
+    }
+
+    template <typename Spec, typename F>
+    constexpr auto visit(std::size_t level, std::size_t idx, F &f) const
+        -> void {
+        auto c = candidates<Spec>(level, idx);
+        while (c != 0) {
+            auto const offset = static_cast<std::size_t>(countr_zero(c));
+            c &= c - 1;
+            auto const child = idx * storage_elem_size + offset;
+            if (level == 0) {
+                f(static_cast<iter_arg_t>(child));
+            } else {
+                visit<Spec>(level - 1, child, f);
+            }
+        }
+    }
+
+    constexpr static auto assign_bit(elem_t &word, std::size_t offset,
+                                     bool value) -> bool {
+        auto const old = word;
+        if (value) {
+            word |= bit << offset;
+        } else {
+            word &= ~(bit << offset);
+        }
+        return old != word;
+    }
+
+    // propagate a change in "is word w at level 0 empty/full" upwards
+    constexpr auto propagate(std::size_t w) -> void {
+        auto any = (storage[w] & salient(w)) != 0;
+        auto notfull = (storage[w] & salient(w)) != salient(w);
+        for (auto level = std::size_t{1}; level < num_levels; ++level) {
+            auto const [index, offset] =
+                std::pair{w / storage_elem_size, w % storage_elem_size};
+            auto &ne = nonempty[layout::offsets[level] + index];
+            auto &nf = nonfull[layout::offsets[level] + index];
+            auto const ne_changed = assign_bit(ne, offset, any);
+            auto const nf_changed = assign_bit(nf, offset, notfull);
+            if (not ne_changed and not nf_changed) {
+                return;
+            }
+            any = ne != 0;
+            notfull = nf != 0;
+            w = index;
+        }
+    }
+
+    // recompute all the summaries for level 0 words [first, last]
+    constexpr auto rebuild(std::size_t first, std::size_t last) -> void {
+        for (auto w = first; w <= last; ++w) {
+            propagate(w);
+        }
+    }
+
+    constexpr auto rebuild() -> void {
+        if constexpr (N != 0) {
+            rebuild(0, storage_size - 1);
+        }
+    }
+
+  public:
+    constexpr hierarchical_bitset() { rebuild(); }
+
+    constexpr explicit hierarchical_bitset(std::uint64_t value) {
+        if constexpr (N != 0) {
+            storage[0] = value & salient(0);
+        }
+        rebuild();
+    }
+
+    template <typename... Bs>
+    constexpr explicit hierarchical_bitset(place_bits_t, Bs... bs) {
+        static_assert(((std::is_integral_v<Bs> or std::is_enum_v<Bs>) and ...),
+                      "Bit places must be integral or enumeration types!");
+        rebuild();
+        (set(static_cast<std::size_t>(bs)), ...);
+    }
+
+    constexpr explicit hierarchical_bitset(all_bits_t) { set(); }
+
+    template <typename S>
+    constexpr explicit hierarchical_bitset(bitset<Size, S> const &bs) {
+        stdx::for_each(
+            [&](auto i) {
+                auto const pos = static_cast<std::size_t>(to_underlying(i));
+                storage[pos / storage_elem_size] |=
+                    bit << (pos % storage_elem_size);
+            },
+            bs);
+        rebuild();
+    }
+
+    constexpr static std::integral_constant<std::size_t, N> capacity{};
+
+    template <typename T>
+    [[nodiscard]] constexpr auto operator[](T idx) const -> bool {
+        static_assert(admissible_enum<T>() or
+                          stdx::always_false_v<T, decltype(Size)>,
+                      "T is not the required enumeration type");
+        auto const pos = static_cast<std::size_t>(to_underlying(idx));
+        return (storage[pos / storage_elem_size] &
+                (bit << (pos % storage_elem_size))) != 0;
+    }
+
+    template <typename T>
+    constexpr auto set(T idx, bool value = true) LIFETIMEBOUND
+        -> hierarchical_bitset & {
+        static_assert(admissible_enum<T>() or
+                          stdx::always_false_v<T, decltype(Size)>,
+                      "T is not the required enumeration type");
+        auto const pos = static_cast<std::size_t>(to_underlying(idx));
+        auto const w = pos / storage_elem_size;
+        auto const old = storage[w];
+        assign_bit(storage[w], pos % storage_elem_size, value);
+        // summaries only change when a word becomes (or stops being) empty
+        // or full
+        if (auto const s = salient(w);
+            ((old & s) == 0) != ((storage[w] & s) == 0) or
+            ((old & s) == s) != ((storage[w] & s) == s)) {
+            propagate(w);
+        }
+        return *this;
+    }
+
+    constexpr auto set(lsb_t lsb, msb_t msb, bool value = true) LIFETIMEBOUND
+        -> hierarchical_bitset & {
+        auto const l = to_underlying(lsb);
+        auto const m = to_underlying(msb);
+        detail::bitset_words::set_range(std::data(storage), l, m, value);
+        rebuild(l / storage_elem_size, m / storage_elem_size);
+        return *this;
+    }
+
+    constexpr auto set(lsb_t lsb, length_t len, bool value = true) LIFETIMEBOUND
+        -> hierarchical_bitset & {
+        auto const l = to_underlying(lsb);
+        auto const length = to_underlying(len);
+        return set(lsb, static_cast<msb_t>(l + length - 1), value);
+    }
+
+    constexpr auto set() LIFETIMEBOUND -> hierarchical_bitset & {
+        for (auto &elem : storage) {
+            elem = allbits;
+        }
+        rebuild();
+        return *this;
+    }
+
+    template <typename T>
+    constexpr auto reset(T idx) LIFETIMEBOUND -> hierarchical_bitset & {
+        return set(idx, false);
+    }
+
+    constexpr auto reset() LIFETIMEBOUND -> hierarchical_bitset & {
+        for (auto &elem : storage) {
+            elem = {};
+        }
+        rebuild();
+        return *this;
+    }
+
+    constexpr auto reset(lsb_t lsb, msb_t msb) LIFETIMEBOUND
+        -> hierarchical_bitset & {
+        return set(lsb, msb, false);
+    }
+
+    constexpr auto reset(lsb_t lsb, length_t len) LIFETIMEBOUND
+        -> hierarchical_bitset & {
+        return set(lsb, len, false);
+    }
+
+    template <typename... Ts>
+    constexpr auto clear(Ts... ts) LIFETIMEBOUND -> hierarchical_bitset & {
+        return reset(ts...);
+    }
+
+    template <typename T>
+    constexpr auto flip(T idx) LIFETIMEBOUND -> hierarchical_bitset & {
+        return set(idx, not(*this)[idx]);
+    }
+
+    constexpr auto flip() LIFETIMEBOUND -> hierarchical_bitset & {
+        detail::simd::transform(std::data(storage), storage_size,
+                                std::bit_not{});
+        rebuild();
+        return *this;
+    }
+
+    [[nodiscard]] constexpr auto count() const -> std::size_t {
+        if constexpr (N == 0) {
+            return {};
+        } else {
+            return static_cast<std::size_t>(popcount(storage.back() &
+                                                     lastmask)) +
+                   detail::simd::popcount(std::data(storage),
+                                          storage_size - 1);
+        }
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t { return count(); }
+    [[nodiscard]] constexpr auto empty() const -> bool { return none(); }
+
+    [[nodiscard]] constexpr auto all() const -> bool {
+        return find_lowest<unset_bit>() == N;
+    }
+    [[nodiscard]] constexpr auto any() const -> bool {
+        return find_lowest<set_bit>() != N;
+    }
+    [[nodiscard]] constexpr auto none() const -> bool { return not any(); }
+
+    [[nodiscard]] constexpr auto lowest_set() const -> iter_arg_t {
+        return static_cast<iter_arg_t>(find_lowest<set_bit>());
+    }
+    [[nodiscard]] constexpr auto lowest_unset() const -> iter_arg_t {
+        return static_cast<iter_arg_t>(find_lowest<unset_bit>());
+    }
+
+    template <detail::bit_spec Spec = set_bit, typename F>
+    constexpr auto for_each(F &&f) const -> F {
+        static_assert(not std::is_same_v<Spec, stdx::bit>,
+                      "hierarchical_bitset iterates set or unset bits");
+        if constexpr (N != 0) {
+            visit<Spec>(num_levels - 1, 0, f);
+        }
+        return std::forward<F>(f);
+    }
+
+    template <typename T, typename F, typename R>
+    constexpr auto transform_reduce(F &&f, R &&r, T init) const -> T {
+        for_each([&](auto i) { init = r(std::move(init), f(i)); });
+        return init;
+    }
+
+    [[nodiscard]] constexpr auto to_bitset() const -> bitset<Size> {
+        auto bs = bitset<Size>{};
+        for_each([&](auto i) { bs.set(i); });
+        return bs;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(hierarchical_bitset const &lhs, hierarchical_bitset const &rhs)
+        -> bool {
+        if constexpr (N == 0) {
+            return true;
+        } else {
+            return detail::simd::equal(std::data(lhs.storage),
+                                       std::data(rhs.storage),
+                                       storage_size - 1) and
+                   (lhs.storage.back() & lastmask) ==
+                       (rhs.storage.back() & lastmask);
+        }
+    }
+};
+
+template <detail::bit_spec Spec = set_bit, typename F, auto M>
+constexpr auto for_each(F &&f, hierarchical_bitset<M> const &bs) -> F {
+    return bs.template for_each<Spec>(std::forward<F>(f));
+}
+
+template <typename T, typename F, typename R, auto M>
+[[nodiscard]] constexpr auto transform_reduce(F &&f, R &&r, T init,
+                                              hierarchical_bitset<M> const &bs)
+    -> T {
+    return bs.transform_reduce(std::forward<F>(f), std::forward<R>(r),
+                               std::move(init));
+}
+} // namespace v1
+} // namespace stdx
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <stdx/bit.hpp>
+#include <stdx/bitset.hpp>
+#include <stdx/detail/bitset_common.hpp>
+#include <stdx/type_traits.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace stdx {
+inline namespace v1 {
+// An immutable copy of a bitset with an index for O(1) rank and near-O(1)
+// select. The index follows the "poppy" layout: one 64-bit entry per 2048-bit
+// block holds the number of set bits before the block (32 bits) and the counts
+// of the first three 512-bit sub-blocks (10 bits each). A sample of every
+// 8192nd set bit's block narrows select's search. The index adds about 3.5% to
+// the size of the bits.
+template <auto Size> class rank_select {
+    constexpr static std::size_t N = to_underlying(Size);
+    static_assert(N < (std::size_t{1} << 32u),
+                  "rank_select supports up to 2^32 - 1 bits");
+
+    constexpr static auto word_bits = std::size_t{64};
+    constexpr static auto num_words = (N + word_bits - 1) / word_bits;
+    constexpr static auto words_per_sub_block = std::size_t{8};
+    constexpr static auto words_per_block = 4 * words_per_sub_block;
+    constexpr static auto block_bits = words_per_block * word_bits;
+    constexpr static auto num_blocks =
+        (num_words + words_per_block - 1) / words_per_block;
+    constexpr static auto sample_rate = std::size_t{8192};
+    constexpr static auto num_samples = N / sample_rate + 1;
+
+    std::array<std::uint64_t, num_words> words{};
+    std::array<std::uint64_t, num_blocks> blocks{};
+    std::array<std::uint32_t, num_samples> samples{};
+    std::size_t total{};
+
+    [[nodiscard]] constexpr static auto cumulative(std::uint64_t entry)
+        -> std::size_t {
+        return entry & 0xffff'ffffu;
+    }
+    [[nodiscard]] constexpr static auto sub_count(std::uint64_t entry,
+                                                  std::size_t j)
+        -> std::size_t {
+        return (entry >> (32u + 10u * j)) & 0x3ffu;
+    }
+
+    [[nodiscard]] constexpr auto popcount_words(std::size_t first,
+                                                std::size_t last) const
+        -> std::size_t {
+        auto r = std::size_t{};
+        for (auto w = first; w < last; ++w) {
+            r += static_cast<std::size_t>(popcount(words[w]));
+        }
+        return r;
+    }
+
+    // the position of the k-th set bit of w (which has more than k set bits)
+    [[nodiscard]] constexpr static auto select_in_word(std::uint64_t w,
+                                                       std::size_t k)
+        -> std::size_t {
+        for (auto b = std::size_t{};; b += 8) {
+            auto const byte = static_cast<std::uint8_t>(w >> b);
+            auto const c = static_cast<std::size_t>(popcount(byte));
+            if (k < c) {
+                return b + detail::bitset_words::byte_offsets[byte][k];
+            }
+            k -= c;
+        }
+    }
+
+    constexpr auto build() -> void {
+        auto cum = std::size_t{};
+        auto next_sample = std::size_t{};
+        for (auto b = std::size_t{}; b < num_blocks; ++b) {
+            auto entry = std::uint64_t{cum};
+            auto block_count = std::size_t{};
+            for (auto j = std::size_t{}; j < 4; ++j) {
+                auto const first = std::min(
+                    b * words_per_block + j * words_per_sub_block, num_words);
+                auto const last =
+                    std::min(first + words_per_sub_block, num_words);
+                auto const c = popcount_words(first, last);
+                if (j < 3) {
+                    entry |= static_cast<std::uint64_t>(c) << (32u + 10u * j);
+                }
+                block_count += c;
+            }
+            blocks[b] = entry;
+            cum += block_count;
+            // sample the blocks holding every sample_rate-th set bit
+            while (next_sample < num_samples and
+                   next_sample * sample_rate < cum) {
+                samples[next_sample++] = static_cast<std::uint32_t>(b);
+            }
+        }
+        total = cum;
+        while (next_sample < num_samples) {
+            samples[next_sample++] = static_cast<std::uint32_t>(num_blocks);
+        }
+    }
+
+  public:
+    template <typename S>
+    constexpr explicit rank_select(bitset<Size, S> const &bs) {
+        for_each(
+            [&](auto i) {
+                auto const pos = static_cast<std::size_t>(to_underlying(i));
+                words[pos / word_bits] |= std::uint64_t{1}
+                                          << (pos % word_bits);
+            },
+            bs);
+        build();
+    }
+
+    constexpr static std::integral_constant<std::size_t, N> capacity{};
+
+    template <typename T>
+    [[nodiscard]] constexpr auto operator[](T idx) const -> bool {
+        auto const pos = static_cast<std::size_t>(to_underlying(idx));
+        return ((words[pos / word_bits] >> (pos % word_bits)) & 1u) != 0;
+    }
+
+    [[nodiscard]] constexpr auto count() const -> std::size_t { return total; }
+
+    // the number of set (or unset) bits before pos
+    template <detail::bit_spec Spec = set_bit>
+    [[nodiscard]] constexpr auto rank(std::size_t pos) const -> std::size_t {
+        static_assert(not std::is_same_v<Spec, stdx::bit>,
+                      "Rank set_bit or unset_bit");
+        if constexpr (std::is_same_v<Spec, unset_bit>) {
+            return std::min(pos, N) - rank(pos);
+        } else {
+            if (pos >= N) {
+                return total;
+            }
+            auto const b = pos / block_bits;
+            auto const entry = blocks[b];
+            auto r = cumulative(entry);
+            auto const s = (pos % block_bits) / (words_per_sub_block * 64);
+            for (auto j = std::size_t{}; j < s; ++j) {
+                r += sub_count(entry, j);
+            }
+            auto const w = pos / word_bits;
+            r += popcount_words(b * words_per_block + s * words_per_sub_block,
+                                w);
+            if (auto const offset = pos % word_bits; offset != 0) {
+                r += static_cast<std::size_t>(
+                    popcount(words[w] & ((std::uint64_t{1} << offset) - 1u)));
+            }
+            return r;
+        }
+    }
+
+    // the position of the k-th (from 0) set bit, or capacity() if there are
+    // not that many
+    [[nodiscard]] constexpr auto select(std::size_t k) const -> std::size_t {
+        if (k >= total) {
+            return N;
+        }
+        // find the last block starting with at most k set bits before it
+        auto const sample = k / sample_rate;
+        auto lo = std::size_t{samples[sample]};
+        auto hi = sample + 1 < num_samples
+                      ? std::min(std::size_t{samples[sample + 1]} + 1,
+                                 num_blocks)
+                      : num_blocks;
+        while (hi - lo > 1) {
+            auto const mid = lo + (hi - lo) / 2;
+            if (cumulative(blocks[mid]) <= k) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        auto const entry = blocks[lo];
+        k -= cumulative(entry);
+        auto s = std::size_t{};
+        for (; s < 3; ++s) {
+            auto const c = sub_count(entry, s);
+            if (k < c) {
+                break;
+            }
+            k -= c;
+        }
+        for (auto w = lo * words_per_block + s * words_per_sub_block;; ++w) {
+            auto const c = static_cast<std::size_t>(popcount(words[w]));
+            if (k < c) {
+                return w * word_bits + select_in_word(words[w], k);
+            }
+            k -= c;
+        }
+    }
+};
+
+template <auto Size, typename S>
+rank_select(bitset<Size, S>) -> rank_select<Size>;
+} // namespace v1
+} // namespace stdx
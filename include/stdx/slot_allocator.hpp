@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdx/atomic_bitset.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace stdx {
+inline namespace v1 {
+// A lock-free allocator of N slots (indices 0 to N-1), kept as one bit per
+// slot in an atomic_bitset. Acquiring a slot is one fetch_or on a word that
+// looked free; on a collision the returned value shows which bits remain.
+// Different threads start searching at different words, which spreads
+// contention across the bitset.
+template <std::size_t N> class slot_allocator {
+    static_assert(N > 0, "slot_allocator must have at least one slot");
+
+    atomic_bitset<N, std::uint64_t> slots{};
+
+    // a per-thread starting word, derived from the address of a thread_local
+    [[nodiscard]] static auto thread_hint() -> std::size_t {
+        thread_local char tag{};
+        auto const h =
+            std::uint64_t{reinterpret_cast<std::uintptr_t>(&tag)} *
+            0x9e37'79b9'7f4a'7c15u;
+        return h >> 40u;
+    }
+
+  public:
+    constexpr static std::integral_constant<std::size_t, N> capacity{};
+
+    // Returns the index of a newly acquired slot, or capacity() if every
+    // slot is in use. The search starts at word hint (modulo the number of
+    // words); without a hint, each thread uses its own starting word.
+    [[nodiscard]] auto
+    acquire(std::size_t hint,
+            std::memory_order order = std::memory_order_acquire)
+        -> std::size_t {
+        return slots.acquire_lowest_unset(hint, order);
+    }
+    [[nodiscard]] auto acquire() -> std::size_t {
+        return acquire(thread_hint());
+    }
+
+    auto release(std::size_t slot,
+                 std::memory_order order = std::memory_order_release) -> void {
+        slots.reset(slot, order);
+    }
+
+    [[nodiscard]] auto in_use(std::size_t slot) const -> bool {
+        return slots[slot];
+    }
+
+    // not a snapshot: see atomic_bitset
+    [[nodiscard]] auto
+    count(std::memory_order order = std::memory_order_relaxed) const
+        -> std::size_t {
+        return slots.count(order);
+    }
+};
+} // namespace v1
+} // namespace stdx
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <stdx/compiler.hpp>
+#include <stdx/concepts.hpp>
+#include <stdx/cx_map.hpp>
+#include <stdx/detail/simd.hpp>
+#include <stdx/iterator.hpp>
+#include <stdx/span.hpp>
+#include <stdx/utility.hpp>
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace stdx {
+inline namespace v1 {
+namespace detail {
+// walks the key and value arrays together, giving references to each pair
+template <typename K, typename V> class soa_iterator {
+    K *key{};
+    V *value{};
+
+  public:
+    using value_type =
+        cx_map_value<std::remove_const_t<K>, std::remove_const_t<V>>;
+    using reference = cx_map_value<K &, V &>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using iterator_category = std::input_iterator_tag;
+
+    constexpr soa_iterator() = default;
+    constexpr soa_iterator(K *k, V *v) : key{k}, value{v} {}
+
+    [[nodiscard]] constexpr auto operator*() const -> reference {
+        return {*key, *value};
+    }
+
+    constexpr auto operator++() -> soa_iterator & {
+        ++key;
+        ++value;
+        return *this;
+    }
+    constexpr auto operator++(int) -> soa_iterator {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(soa_iterator const &lhs,
+                                                   soa_iterator const &rhs)
+        -> bool {
+        return lhs.key == rhs.key;
+    }
+};
+} // namespace detail
+
+// A cx_map that keeps its keys and values in separate arrays. A lookup scans
+// only the keys (a vector at a time for integral and enum keys), and reads a
+// value only on a hit.
+template <typename Key, typename Value, std::size_t N> class soa_cx_map {
+  public:
+    using value_type = cx_map_value<Key, Value>;
+    using key_type = Key;
+    using mapped_type = Value;
+    using size_type = std::size_t;
+    using reference = cx_map_value<key_type const &, mapped_type &>;
+    using const_reference =
+        cx_map_value<key_type const &, mapped_type const &>;
+    using iterator = detail::soa_iterator<key_type const, mapped_type>;
+    using const_iterator =
+        detail::soa_iterator<key_type const, mapped_type const>;
+
+  private:
+    std::array<key_type, N> key_storage{};
+    std::array<mapped_type, N> value_storage{};
+    std::size_t current_size{};
+
+    [[nodiscard]] constexpr auto index_of(key_type const &key) const
+        -> std::size_t {
+        return detail::simd::find(std::data(key_storage), current_size, key);
+    }
+
+  public:
+    constexpr soa_cx_map() = default;
+    template <same_as<value_type>... Vs>
+        requires(sizeof...(Vs) <= N)
+    constexpr explicit soa_cx_map(Vs const &...vs)
+        : key_storage{vs.key...}, value_storage{vs.value...},
+          current_size{sizeof...(Vs)} {}
+
+    [[nodiscard]] constexpr auto begin() LIFETIMEBOUND -> iterator {
+        return {std::data(key_storage), std::data(value_storage)};
+    }
+    [[nodiscard]] constexpr auto begin() const LIFETIMEBOUND -> const_iterator {
+        return {std::data(key_storage), std::data(value_storage)};
+    }
+    [[nodiscard]] constexpr auto cbegin() const LIFETIMEBOUND
+        -> const_iterator {
+        return begin();
+    }
+
+    [[nodiscard]] constexpr auto end() LIFETIMEBOUND -> iterator {
+        return {std::data(key_storage) + current_size,
+                std::data(value_storage) + current_size};
+    }
+    [[nodiscard]] constexpr auto end() const LIFETIMEBOUND -> const_iterator {
+        return {std::data(key_storage) + current_size,
+                std::data(value_storage) + current_size};
+    }
+    [[nodiscard]] constexpr auto cend() const LIFETIMEBOUND -> const_iterator {
+        return end();
+    }
+
+    [[nodiscard]] constexpr auto keys() const LIFETIMEBOUND
+        -> span<key_type const> {
+        return {std::data(key_storage), current_size};
+    }
+    [[nodiscard]] constexpr auto values() LIFETIMEBOUND -> span<mapped_type> {
+        return {std::data(value_storage), current_size};
+    }
+    [[nodiscard]] constexpr auto values() const LIFETIMEBOUND
+        -> span<mapped_type const> {
+        return {std::data(value_storage), current_size};
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        return current_size;
+    }
+    constexpr static std::integral_constant<size_type, N> capacity{};
+
+    [[nodiscard]] constexpr auto full() const -> bool {
+        return current_size == N;
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        return current_size == 0;
+    }
+
+    constexpr auto clear() -> void { current_size = 0; }
+
+    [[nodiscard]] constexpr auto pop_back() -> value_type {
+        --current_size;
+        return {key_storage[current_size], value_storage[current_size]};
+    }
+
+    [[nodiscard]] constexpr auto get(key_type const &key) LIFETIMEBOUND
+        -> mapped_type & {
+        if (auto const i = index_of(key); i != current_size) {
+            return value_storage[i];
+        }
+        unreachable();
+    }
+    [[nodiscard]] constexpr auto get(key_type const &key) const LIFETIMEBOUND
+        -> mapped_type const & {
+        if (auto const i = index_of(key); i != current_size) {
+            return value_storage[i];
+        }
+        unreachable();
+    }
+
+    [[nodiscard]] constexpr auto contains(key_type const &key) const -> bool {
+        return index_of(key) != current_size;
+    }
+
+    constexpr auto insert_or_assign(key_type const &key,
+                                    mapped_type const &value) -> bool {
+        if (auto const i = index_of(key); i != current_size) {
+            value_storage[i] = value;
+            return false;
+        }
+        key_storage[current_size] = key;
+        value_storage[current_size++] = value;
+        return true;
+    }
+    constexpr auto put(key_type const &key, mapped_type const &value) -> bool {
+        return insert_or_assign(key, value);
+    }
+
+    constexpr auto erase(key_type const &key) -> size_type {
+        if (auto const i = index_of(key); i != current_size) {
+            --current_size;
+            key_storage[i] = key_storage[current_size];
+            value_storage[i] = value_storage[current_size];
+            return 1u;
+        }
+        return 0u;
+    }
+};
+
+template <typename K, typename V, std::size_t N>
+constexpr auto ct_capacity_v<soa_cx_map<K, V, N>> = N;
+} // namespace v1
+} // namespace stdx
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <stdx/compiler.hpp>
+#include <stdx/concepts.hpp>
+#include <stdx/cx_map.hpp>
+#include <stdx/iterator.hpp>
+#include <stdx/span.hpp>
+#include <stdx/utility.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace stdx {
+inline namespace v1 {
+namespace detail::sorted {
+// The index of the first element of [first, first + n) for which pred is
+// false. Each step halves the range with a select rather than a branch, so the
+// loop runs the same number of times whatever the result.
+template <typename T, typename Pred>
+[[nodiscard]] constexpr auto partition_point(T const *first, std::size_t n,
+                                             Pred const &pred) -> std::size_t {
+    if (n == 0) {
+        return 0;
+    }
+    auto base = std::size_t{};
+    while (n > 1) {
+        auto const half = n / 2;
+        base = pred(first[base + half]) ? base + half : base;
+        n -= half;
+    }
+    return base + static_cast<std::size_t>(pred(first[base]));
+}
+
+// a bottom-up merge sort: stable and constexpr, unlike std::stable_sort
+template <typename T, typename Less>
+constexpr auto stable_sort(T *first, std::size_t n, T *buffer,
+                           Less const &less) -> void {
+    for (auto width = std::size_t{1}; width < n; width *= 2) {
+        for (auto lo = std::size_t{}; lo < n; lo += 2 * width) {
+            auto const mid = std::min(lo + width, n);
+            auto const hi = std::min(lo + 2 * width, n);
+            auto l = lo;
+            auto r = mid;
+            auto out = lo;
+            while (l < mid and r < hi) {
+                buffer[out++] = std::move(
+                    less(first[r], first[l]) ? first[r++] : first[l++]);
+            }
+            std::move(first + l, first + mid, buffer + out);
+            std::move(first + r, first + hi, buffer + out + (mid - l));
+        }
+        std::move(buffer, buffer + n, first);
+    }
+}
+
+// collapses each run of equivalent elements to its last element
+template <typename T, typename Less>
+[[nodiscard]] constexpr auto unique_last(T *first, std::size_t n,
+                                         Less const &less) -> std::size_t {
+    auto out = std::size_t{};
+    for (auto i = std::size_t{}; i < n; ++i) {
+        if (out != 0 and not less(first[out - 1], first[i])) {
+            first[out - 1] = std::move(first[i]);
+        } else {
+            first[out++] = std::move(first[i]);
+        }
+    }
+    return out;
+}
+} // namespace detail::sorted
+
+// An ordered map with a compile-time capacity, whose entries are kept sorted
+// by key in one array. Lookup is a branchless binary search.
+template <typename Key, typename Value, std::size_t N,
+          typename Compare = std::less<>>
+class sorted_cx_map {
+  public:
+    using value_type = cx_map_value<Key, Value>;
+    using key_type = typename value_type::key_type;
+    using mapped_type = typename value_type::mapped_type;
+    using key_compare = Compare;
+    using size_type = std::size_t;
+    using reference = value_type &;
+    using const_reference = value_type const &;
+    using iterator = value_type *;
+    using const_iterator = value_type const *;
+
+  private:
+    std::array<value_type, N> storage{};
+    std::size_t current_size{};
+    [[no_unique_address]] Compare less{};
+
+    constexpr auto entry_less() const {
+        return [&](value_type const &x, value_type const &y) {
+            return less(x.key, y.key);
+        };
+    }
+
+    [[nodiscard]] constexpr auto index_of(key_type const &key) const
+        -> std::size_t {
+        return detail::sorted::partition_point(
+            std::data(storage), current_size,
+            [&](value_type const &v) { return less(v.key, key); });
+    }
+
+    [[nodiscard]] constexpr auto found(std::size_t i,
+                                       key_type const &key) const -> bool {
+        return i != current_size and not less(key, storage[i].key);
+    }
+
+    // sorts the entries and keeps the last of any with equivalent keys
+    constexpr auto normalize() -> void {
+        std::array<value_type, N> buffer{};
+        detail::sorted::stable_sort(std::data(storage), current_size,
+                                    std::data(buffer), entry_less());
+        current_size = detail::sorted::unique_last(
+            std::data(storage), current_size, entry_less());
+    }
+
+  public:
+    constexpr sorted_cx_map() = default;
+    constexpr explicit sorted_cx_map(Compare c) : less{std::move(c)} {}
+
+    template <same_as<value_type>... Vs>
+        requires(sizeof...(Vs) <= N)
+    constexpr explicit sorted_cx_map(Vs const &...vs)
+        : storage{vs...}, current_size{sizeof...(Vs)} {
+        normalize();
+    }
+
+    [[nodiscard]] constexpr auto begin() LIFETIMEBOUND -> iterator {
+        return std::data(storage);
+    }
+    [[nodiscard]] constexpr auto begin() const LIFETIMEBOUND -> const_iterator {
+        return std::data(storage);
+    }
+    [[nodiscard]] constexpr auto cbegin() const LIFETIMEBOUND
+        -> const_iterator {
+        return std::data(storage);
+    }
+
+    [[nodiscard]] constexpr auto end() LIFETIMEBOUND -> iterator {
+        return begin() + current_size;
+    }
+    [[nodiscard]] constexpr auto end() const LIFETIMEBOUND -> const_iterator {
+        return begin() + current_size;
+    }
+    [[nodiscard]] constexpr auto cend() const LIFETIMEBOUND -> const_iterator {
+        return cbegin() + current_size;
+    }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        return current_size;
+    }
+    constexpr static std::integral_constant<size_type, N> capacity{};
+
+    [[nodiscard]] constexpr auto full() const -> bool {
+        return current_size == N;
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        return current_size == 0;
+    }
+
+    constexpr auto clear() -> void { current_size = 0; }
+
+    // removes the entry with the greatest key
+    [[nodiscard]] constexpr auto pop_back() -> value_type {
+        return storage[--current_size];
+    }
+
+    [[nodiscard]] constexpr auto lower_bound(key_type const &key) const
+        LIFETIMEBOUND -> const_iterator {
+        return begin() + index_of(key);
+    }
+    [[nodiscard]] constexpr auto upper_bound(key_type const &key) const
+        LIFETIMEBOUND -> const_iterator {
+        return begin() + detail::sorted::partition_point(
+                             std::data(storage), current_size,
+                             [&](value_type const &v) {
+                                 return not less(key, v.key);
+                             });
+    }
+    [[nodiscard]] constexpr auto equal_range(key_type const &key) const
+        LIFETIMEBOUND -> std::pair<const_iterator, const_iterator> {
+        auto const i = index_of(key);
+        return {begin() + i, begin() + i + (found(i, key) ? 1 : 0)};
+    }
+
+    [[nodiscard]] constexpr auto find(key_type const &key) const LIFETIMEBOUND
+        -> const_iterator {
+        auto const i = index_of(key);
+        return found(i, key) ? begin() + i : end();
+    }
+
+    [[nodiscard]] constexpr auto get(key_type const &key) LIFETIMEBOUND
+        -> mapped_type & {
+        if (auto const i = index_of(key); found(i, key)) {
+            return storage[i].value;
+        }
+        unreachable();
+    }
+    [[nodiscard]] constexpr auto get(key_type const &key) const LIFETIMEBOUND
+        -> mapped_type const & {
+        if (auto const i = index_of(key); found(i, key)) {
+            return storage[i].value;
+        }
+        unreachable();
+    }
+
+    [[nodiscard]] constexpr auto contains(key_type const &key) const -> bool {
+        return found(index_of(key), key);
+    }
+
+    constexpr auto insert_or_assign(key_type const &key,
+                                    mapped_type const &value) -> bool {
+        auto const i = index_of(key);
+        if (found(i, key)) {
+            storage[i].value = value;
+            return false;
+        }
+        std::move_backward(begin() + i, end(), end() + 1);
+        storage[i] = {key, value};
+        ++current_size;
+        return true;
+    }
+    constexpr auto put(key_type const &key, mapped_type const &value) -> bool {
+        return insert_or_assign(key, value);
+    }
+
+    // Appends the entries and sorts once: where keys are repeated, the last
+    // entry wins. The entries must fit in the unused capacity.
+    template <typename V, std::size_t Extent>
+    constexpr auto insert_or_assign(span<V, Extent> entries) -> void {
+        for (auto const &e : entries) {
+            storage[current_size++] = e;
+        }
+        normalize();
+    }
+
+    constexpr auto erase(key_type const &key) -> size_type {
+        if (auto const i = index_of(key); found(i, key)) {
+            std::move(begin() + i + 1, end(), begin() + i);
+            --current_size;
+            return 1u;
+        }
+        return 0u;
+    }
+};
+
+template <typename K, typename V, std::size_t N, typename C>
+constexpr auto ct_capacity_v<sorted_cx_map<K, V, N, C>> = N;
+} // namespace v1
+} // namespace stdx
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <stdx/compiler.hpp>
+#include <stdx/concepts.hpp>
+#include <stdx/iterator.hpp>
+#include <stdx/sorted_cx_map.hpp>
+#include <stdx/span.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace stdx {
+inline namespace v1 {
+namespace detail::sorted {
+// merges two sorted ranges of distinct keys, writing each key once
+template <typename T, typename Less>
+constexpr auto set_union(T const *a, std::size_t na, T const *b,
+                         std::size_t nb, T *out, Less const &less)
+    -> std::size_t {
+    auto i = std::size_t{};
+    auto j = std::size_t{};
+    auto n = std::size_t{};
+    while (i < na and j < nb) {
+        auto const a_first = less(a[i], b[j]);
+        auto const b_first = less(b[j], a[i]);
+        out[n++] = b_first ? b[j] : a[i];
+        i += b_first ? 0u : 1u;
+        j += a_first ? 0u : 1u;
+    }
+    std::copy(a + i, a + na, out + n);
+    n += na - i;
+    std::copy(b + j, b + nb, out + n);
+    return n + nb - j;
+}
+
+template <typename T, typename Less>
+constexpr auto set_intersection(T const *a, std::size_t na, T const *b,
+                                std::size_t nb, T *out, Less const &less)
+    -> std::size_t {
+    auto i = std::size_t{};
+    auto j = std::size_t{};
+    auto n = std::size_t{};
+    while (i < na and j < nb) {
+        auto const a_first = less(a[i], b[j]);
+        auto const b_first = less(b[j], a[i]);
+        if (not a_first and not b_first) {
+            out[n++] = a[i];
+        }
+        i += b_first ? 0u : 1u;
+        j += a_first ? 0u : 1u;
+    }
+    return n;
+}
+} // namespace detail::sorted
+
+// An ordered set with a compile-time capacity, whose keys are kept sorted in
+// one array. Lookup is a branchless binary search, and union and intersection
+// are linear merges.
+template <typename Key, std::size_t N, typename Compare = std::less<>>
+class sorted_cx_set {
+    std::array<Key, N> storage{};
+    std::size_t current_size{};
+    [[no_unique_address]] Compare less{};
+
+    template <typename, std::size_t, typename> friend class sorted_cx_set;
+
+    [[nodiscard]] constexpr auto index_of(Key const &key) const
+        -> std::size_t {
+        return detail::sorted::partition_point(
+            std::data(storage), current_size,
+            [&](Key const &k) { return less(k, key); });
+    }
+
+    [[nodiscard]] constexpr auto found(std::size_t i, Key const &key) const
+        -> bool {
+        return i != current_size and not less(key, storage[i]);
+    }
+
+    constexpr auto normalize() -> void {
+        std::array<Key, N> buffer{};
+        detail::sorted::stable_sort(std::data(storage), current_size,
+                                    std::data(buffer), less);
+        current_size =
+            detail::sorted::unique_last(std::data(storage), current_size, less);
+    }
+
+  public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using size_type = std::size_t;
+    using reference = value_type &;
+    using const_reference = value_type const &;
+    using iterator = value_type const *;
+    using const_iterator = value_type const *;
+
+    constexpr sorted_cx_set() = default;
+    constexpr explicit sorted_cx_set(Compare c) : less{std::move(c)} {}
+
+    template <convertible_to<key_type>... Ts>
+        requires(sizeof...(Ts) <= N)
+    constexpr explicit sorted_cx_set(Ts const &...ts)
+        : storage{static_cast<key_type>(ts)...}, current_size{sizeof...(Ts)} {
+        normalize();
+    }
+
+    [[nodiscard]] constexpr auto begin() const LIFETIMEBOUND -> const_iterator {
+        return std::data(storage);
+    }
+    [[nodiscard]] constexpr auto cbegin() const LIFETIMEBOUND
+        -> const_iterator {
+        return std::data(storage);
+    }
+    [[nodiscard]] constexpr auto end() const LIFETIMEBOUND -> const_iterator {
+        return begin() + current_size;
+    }
+    [[nodiscard]] constexpr auto cend() const LIFETIMEBOUND -> const_iterator {
+        return cbegin() + current_size;
+    }
+
+    [[nodiscard]] constexpr auto size() const -> size_type {
+        return current_size;
+    }
+    constexpr static std::integral_constant<size_type, N> capacity{};
+
+    [[nodiscard]] constexpr auto full() const -> bool {
+        return current_size == N;
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        return current_size == 0u;
+    }
+
+    constexpr auto clear() -> void { current_size = 0; }
+
+    // removes the greatest key
+    [[nodiscard]] constexpr auto pop_back() -> key_type {
+        return storage[--current_size];
+    }
+
+    [[nodiscard]] constexpr auto lower_bound(key_type const &key) const
+        LIFETIMEBOUND -> const_iterator {
+        return begin() + index_of(key);
+    }
+    [[nodiscard]] constexpr auto upper_bound(key_type const &key) const
+        LIFETIMEBOUND -> const_iterator {
+        return begin() +
+               detail::sorted::partition_point(
+                   std::data(storage), current_size,
+                   [&](Key const &k) { return not less(key, k); });
+    }
+    [[nodiscard]] constexpr auto equal_range(key_type const &key) const
+        LIFETIMEBOUND -> std::pair<const_iterator, const_iterator> {
+        auto const i = index_of(key);
+        return {begin() + i, begin() + i + (found(i, key) ? 1 : 0)};
+    }
+
+    [[nodiscard]] constexpr auto find(key_type const &key) const LIFETIMEBOUND
+        -> const_iterator {
+        auto const i = index_of(key);
+        return found(i, key) ? begin() + i : end();
+    }
+
+    [[nodiscard]] constexpr auto contains(key_type const &key) const -> bool {
+        return found(index_of(key), key);
+    }
+
+    constexpr auto insert(key_type const &key) -> bool {
+        auto const i = index_of(key);
+        if (found(i, key)) {
+            return false;
+        }
+        std::move_backward(std::data(storage) + i,
+                           std::data(storage) + current_size,
+                           std::data(storage) + current_size + 1);
+        storage[i] = key;
+        ++current_size;
+        return true;
+    }
+
+    // Appends the keys and sorts once. The keys must fit in the unused
+    // capacity.
+    template <typename K, std::size_t Extent>
+    constexpr auto insert(span<K, Extent> keys) -> void {
+        for (auto const &k : keys) {
+            storage[current_size++] = k;
+        }
+        normalize();
+    }
+
+    constexpr auto erase(key_type const &key) -> size_type {
+        if (auto const i = index_of(key); found(i, key)) {
+            std::move(std::data(storage) + i + 1,
+                      std::data(storage) + current_size,
+                      std::data(storage) + i);
+            --current_size;
+            return 1u;
+        }
+        return 0u;
+    }
+
+    // a linear merge: the union must fit in this set's capacity
+    template <std::size_t M>
+    constexpr auto merge(sorted_cx_set<Key, M, Compare> const &s) -> void {
+        std::array<Key, N> buffer{};
+        current_size = detail::sorted::set_union(
+            std::data(storage), current_size, std::data(s.storage),
+            s.current_size, std::data(buffer), less);
+        std::move(std::data(buffer), std::data(buffer) + current_size,
+                  std::data(storage));
+    }
+
+    template <typename K, std::size_t A, std::size_t B, typename C>
+    friend constexpr auto set_union(sorted_cx_set<K, A, C> const &,
+                                    sorted_cx_set<K, B, C> const &)
+        -> sorted_cx_set<K, A + B, C>;
+
+    template <typename K, std::size_t A, std::size_t B, typename C>
+    friend constexpr auto set_intersection(sorted_cx_set<K, A, C> const &,
+                                           sorted_cx_set<K, B, C> const &)
+        -> sorted_cx_set<K, (A < B ? A : B), C>;
+
+    [[nodiscard]] friend constexpr auto operator==(sorted_cx_set const &lhs,
+                                                   sorted_cx_set const &rhs)
+        -> bool {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+};
+
+template <typename T, typename... Ts>
+sorted_cx_set(T, Ts...) -> sorted_cx_set<T, 1 + sizeof...(Ts)>;
+
+template <typename K, std::size_t A, std::size_t B, typename C>
+[[nodiscard]] constexpr auto set_union(sorted_cx_set<K, A, C> const &lhs,
+                                       sorted_cx_set<K, B, C> const &rhs)
+    -> sorted_cx_set<K, A + B, C> {
+    sorted_cx_set<K, A + B, C> r{lhs.less};
+    r.current_size = detail::sorted::set_union(
+        std::data(lhs.storage), lhs.current_size, std::data(rhs.storage),
+        rhs.current_size, std::data(r.storage), lhs.less);
+    return r;
+}
+
+template <typename K, std::size_t A, std::size_t B, typename C>
+[[nodiscard]] constexpr auto
+set_intersection(sorted_cx_set<K, A, C> const &lhs,
+                 sorted_cx_set<K, B, C> const &rhs)
+    -> sorted_cx_set<K, (A < B ? A : B), C> {
+    sorted_cx_set<K, (A < B ? A : B), C> r{lhs.less};
+    r.current_size = detail::sorted::set_intersection(
+        std::data(lhs.storage), lhs.current_size, std::data(rhs.storage),
+        rhs.current_size, std::data(r.storage), lhs.less);
+    return r;
+}
+
+template <typename K, std::size_t N, typename C>
+constexpr auto ct_capacity_v<sorted_cx_set<K, N, C>> = N;
+} // namespace v1
+} // namespace stdx
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <stdx/bit.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+
+// A tagged_ptr is two words, so it needs a double-width compare-exchange:
+// cmpxchg16b on x86-64 (which requires -mcx16), casp or ldaxp/stlxp on
+// AArch64, or a plain 64-bit compare-exchange on 32-bit targets.
+#if UINTPTR_MAX > 0xffff'ffffu
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16) and defined(__SIZEOF_INT128__)
+#define STDX_DOUBLE_WIDTH_CAS 1
+#endif
+#else
+#define STDX_DOUBLE_WIDTH_CAS 1
+#endif
+
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+namespace stdx {
+inline namespace v1 {
+// A pointer with a tag (a modification counter). Bumping the tag on every
+// update of an atomic_tagged_ptr defeats the ABA problem in lock-free
+// structures such as stacks and freelists of intrusive nodes.
+template <typename T> struct tagged_ptr {
+    T *ptr{};
+    std::uintptr_t tag{};
+
+    [[nodiscard]] constexpr auto next(T *p) const -> tagged_ptr {
+        return {p, tag + 1};
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(tagged_ptr const &,
+                                                   tagged_ptr const &)
+        -> bool = default;
+};
+
+namespace detail {
+#ifdef STDX_DOUBLE_WIDTH_CAS
+#if UINTPTR_MAX > 0xffff'ffffu
+__extension__ using double_word_t = unsigned __int128;
+#else
+using double_word_t = std::uint64_t;
+#endif
+#endif
+
+template <typename> constexpr auto has_double_width_cas =
+#ifdef STDX_DOUBLE_WIDTH_CAS
+    true;
+#else
+    false;
+#endif
+} // namespace detail
+
+// An atomic tagged_ptr, updated with a double-width compare-exchange. Every
+// operation is sequentially consistent; the memory order arguments are
+// accepted for compatibility with stdx::atomic.
+template <typename T> class atomic_tagged_ptr {
+    static_assert(detail::has_double_width_cas<T>,
+                  "atomic_tagged_ptr requires a double-width compare-exchange "
+                  "(on x86-64, compile with -mcx16)");
+
+#ifdef STDX_DOUBLE_WIDTH_CAS
+    using value_t = tagged_ptr<T>;
+    using word_t = detail::double_word_t;
+    static_assert(sizeof(value_t) == sizeof(word_t));
+
+    alignas(sizeof(word_t)) mutable word_t value{};
+
+    [[nodiscard]] auto cas(word_t expected, word_t desired) const -> word_t {
+        return __sync_val_compare_and_swap(&value, expected, desired);
+    }
+
+  public:
+    using value_type = value_t;
+
+    atomic_tagged_ptr() = default;
+    explicit atomic_tagged_ptr(value_t v) : value{bit_cast<word_t>(v)} {}
+    atomic_tagged_ptr(atomic_tagged_ptr const &) = delete;
+    auto operator=(atomic_tagged_ptr const &) -> atomic_tagged_ptr & = delete;
+
+    // a compare-exchange that writes back what it reads
+    [[nodiscard]] auto load(std::memory_order = std::memory_order_seq_cst) const
+        -> value_t {
+        return bit_cast<value_t>(cas(word_t{}, word_t{}));
+    }
+
+    auto store(value_t v, std::memory_order mo = std::memory_order_seq_cst)
+        -> void {
+        [[maybe_unused]] auto const old = exchange(v, mo);
+    }
+
+    auto exchange(value_t v, std::memory_order = std::memory_order_seq_cst)
+        -> value_t {
+        auto const desired = bit_cast<word_t>(v);
+        auto expected = word_t{};
+        while (true) {
+            auto const prev = cas(expected, desired);
+            if (prev == expected) {
+                return bit_cast<value_t>(prev);
+            }
+            expected = prev;
+        }
+    }
+
+    auto compare_exchange_strong(value_t &expected, value_t desired,
+                                 std::memory_order = std::memory_order_seq_cst,
+                                 std::memory_order = std::memory_order_seq_cst)
+        -> bool {
+        auto const e = bit_cast<word_t>(expected);
+        auto const prev = cas(e, bit_cast<word_t>(desired));
+        expected = bit_cast<value_t>(prev);
+        return prev == e;
+    }
+
+    auto compare_exchange_weak(value_t &expected, value_t desired,
+                               std::memory_order success =
+                                   std::memory_order_seq_cst,
+                               std::memory_order failure =
+                                   std::memory_order_seq_cst) -> bool {
+        return compare_exchange_strong(expected, desired, success, failure);
+    }
+#endif
+};
+} // namespace v1
+} // namespace stdx
@@ -4,6 +4,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <cstdint>
+#include <thread>
 #include <type_traits>
 
 TEMPLATE_TEST_CASE("atomic size and alignment is the same as the data",
@@ -157,3 +158,59 @@ TEST_CASE("operator ^=", "[atomic]") {
     CHECK((val ^= 0b1) == 0b100);
     CHECK(val.load() == 0b100);
 }
+
+TEST_CASE("compare_exchange_strong", "[atomic]") {
+    stdx::atomic<std::uint32_t> val{17};
+    auto expected = std::uint32_t{42};
+    CHECK(not val.compare_exchange_strong(expected, 1337));
+    CHECK(expected == 17);
+    CHECK(val.compare_exchange_strong(expected, 1337));
+    CHECK(val.load() == 1337);
+}
+
+TEST_CASE("compare_exchange_weak", "[atomic]") {
+    stdx::atomic<std::uint32_t> val{17};
+    auto expected = std::uint32_t{17};
+    while (not val.compare_exchange_weak(expected, 1337,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+    }
+    CHECK(val.load() == 1337);
+}
+
+TEST_CASE("fetch_update", "[atomic]") {
+    stdx::atomic<std::uint32_t> val{17};
+    CHECK(val.fetch_update([](auto x) { return x * 2; }) == 17);
+    CHECK(val.load() == 34);
+    CHECK(val.fetch_update([](auto x) { return x + 1; },
+                           std::memory_order_relaxed,
+                           stdx::exponential_backoff{}) == 34);
+    CHECK(val.load() == 35);
+}
+
+TEST_CASE("fetch_update under contention", "[atomic]") {
+    stdx::atomic<std::uint32_t> val{0};
+    auto work = [&] {
+        for (auto i = 0; i < 1000; ++i) {
+            val.fetch_update([](auto x) { return x + 3; },
+                             std::memory_order_relaxed,
+                             stdx::yield_backoff{});
+        }
+    };
+    auto t1 = std::thread(work);
+    auto t2 = std::thread(work);
+    t1.join();
+    t2.join();
+    CHECK(val.load() == 6000);
+}
+
+TEST_CASE("wait and notify", "[atomic]") {
+    stdx::atomic<std::uint32_t> val{0};
+    auto t = std::thread([&] {
+        val.wait(0);
+        CHECK(val.load() == 1);
+    });
+    val.store(1);
+    val.notify_one();
+    t.join();
+}
@@ -380,3 +380,249 @@ TEST_CASE("construct with a ct_string", "[atomic_bitset]") {
     CHECK(stdx::atomic_bitset{"101010101"_cts} ==
           stdx::bitset<9ul, std::uint16_t>{0b101010101ul});
 }
+
+TEST_CASE("atomic_bitset with more than one storage element",
+          "[atomic_bitset]") {
+    STATIC_REQUIRE(sizeof(stdx::atomic_bitset<65>) ==
+                   2 * sizeof(std::uint64_t));
+    STATIC_REQUIRE(sizeof(stdx::atomic_bitset<20, std::uint8_t>) ==
+                   3 * sizeof(std::uint8_t));
+    STATIC_REQUIRE(stdx::atomic_bitset<200>::size() == 200);
+}
+
+TEMPLATE_TEST_CASE("multi-word construct and load", "[atomic_bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t) {
+    using bitset_t = stdx::bitset<130, TestType>;
+    auto const bs = stdx::atomic_bitset<130, TestType>{stdx::place_bits, 0,
+                                                       64, 129};
+    CHECK(bs.load() == bitset_t{stdx::place_bits, 0, 64, 129});
+    CHECK(bs[0]);
+    CHECK(bs[64]);
+    CHECK(bs[129]);
+    CHECK(not bs[128]);
+    CHECK(bs.count() == 3);
+    CHECK(bs.any());
+    CHECK(not bs.none());
+    CHECK(not bs.all());
+
+    auto const all = stdx::atomic_bitset<130, TestType>{stdx::all_bits};
+    CHECK(all.all());
+    CHECK(all.count() == 130);
+    CHECK(all.load() == bitset_t{stdx::all_bits});
+}
+
+TEMPLATE_TEST_CASE("multi-word construct with a value", "[atomic_bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t) {
+    auto const bs = stdx::atomic_bitset<40, TestType>{0xff'0000'00ffull};
+    CHECK(bs.template to<std::uint64_t>() == 0xff'0000'00ffull);
+    CHECK(bs.count() == 16);
+    CHECK(bs.to_natural() == 0xff'0000'00ffull);
+}
+
+TEMPLATE_TEST_CASE("multi-word single bit operations", "[atomic_bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t) {
+    auto bs = stdx::atomic_bitset<100, TestType>{};
+    CHECK(not bs.set(70)[70]);
+    CHECK(bs[70]);
+    CHECK(bs.set(70)[70]);
+    CHECK(bs.flip(99)[99] == false);
+    CHECK(bs[99]);
+    CHECK(bs.reset(70)[70]);
+    CHECK(not bs[70]);
+    CHECK(bs.count() == 1);
+}
+
+TEMPLATE_TEST_CASE("multi-word range operations", "[atomic_bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t) {
+    using namespace stdx::literals;
+    using bitset_t = stdx::bitset<150, TestType>;
+    auto bs = stdx::atomic_bitset<150, TestType>{};
+    bs.set(10_lsb, 140_msb);
+    auto expected = bitset_t{};
+    expected.set(10_lsb, 140_msb);
+    CHECK(bs.load() == expected);
+
+    bs.reset(20_lsb, 100_len);
+    expected.reset(20_lsb, 100_len);
+    CHECK(bs.load() == expected);
+
+    bs.flip(0_lsb, 149_msb);
+    CHECK(bs.load() == ~expected);
+
+    bs.flip();
+    CHECK(bs.load() == expected);
+}
+
+TEMPLATE_TEST_CASE("multi-word range operations return previous words",
+                   "[atomic_bitset]", std::uint8_t, std::uint64_t) {
+    using namespace stdx::literals;
+    auto bs = stdx::atomic_bitset<150, TestType>{stdx::place_bits, 0, 70};
+    auto const prev = bs.set(68_lsb, 72_msb);
+    CHECK(prev[70]);
+    CHECK(not prev[69]);
+    CHECK(bs.count() == 6);
+}
+
+TEMPLATE_TEST_CASE("multi-word whole-set operations", "[atomic_bitset]",
+                   std::uint8_t, std::uint64_t) {
+    using bitset_t = stdx::bitset<150, TestType>;
+    auto bs = stdx::atomic_bitset<150, TestType>{};
+    bs.set();
+    CHECK(bs.all());
+    CHECK(bs.count() == 150);
+    bs.reset();
+    CHECK(bs.none());
+    bs.store(bitset_t{stdx::place_bits, 1, 149});
+    CHECK(bs.load() == bitset_t{stdx::place_bits, 1, 149});
+}
+
+TEST_CASE("seqlock snapshot", "[atomic_bitset]") {
+    using namespace stdx::literals;
+    using bitset_t = stdx::bitset<256, std::uint64_t>;
+    auto bs = stdx::atomic_bitset<256, std::uint64_t,
+                                  stdx::seqlock_snapshot>{};
+    bs.set(10);
+    bs.set(0_lsb, 255_msb);
+    CHECK(bs.all());
+    bs.flip(200_lsb, 255_msb);
+    CHECK(bs.count() == 200);
+    bs.store(bitset_t{stdx::place_bits, 3});
+    CHECK(bs.load() == bitset_t{stdx::place_bits, 3});
+}
+
+TEST_CASE("seqlock snapshot sees whole writes", "[atomic_bitset]") {
+    using namespace stdx::literals;
+    auto bs = stdx::atomic_bitset<256, std::uint64_t,
+                                  stdx::seqlock_snapshot>{};
+    auto t = std::thread([&] {
+        for (auto i = 0; i < 1000; ++i) {
+            bs.flip(0_lsb, 255_msb, std::memory_order_relaxed);
+        }
+    });
+    for (auto i = 0; i < 1000; ++i) {
+        auto const n = bs.count(std::memory_order_relaxed);
+        CHECK((n == 0 or n == 256));
+    }
+    t.join();
+    CHECK(bs.none());
+}
+
+TEMPLATE_TEST_CASE("acquire lowest unset bit", "[atomic_bitset]",
+                   std::uint8_t, std::uint64_t) {
+    auto bs = stdx::atomic_bitset<20, TestType>{0b1011ul};
+    CHECK(bs.acquire_lowest_unset() == 2);
+    CHECK(bs.acquire_lowest_unset() == 4);
+    CHECK(bs.count() == 5);
+    bs.set();
+    CHECK(bs.acquire_lowest_unset() == bs.size());
+}
+
+TEST_CASE("acquire lowest unset bit from a starting word",
+          "[atomic_bitset]") {
+    auto bs = stdx::atomic_bitset<130, std::uint64_t>{};
+    CHECK(bs.acquire_lowest_unset(1) == 64);
+    CHECK(bs.acquire_lowest_unset(2) == 128);
+    CHECK(bs.acquire_lowest_unset(2) == 129);
+    CHECK(bs.acquire_lowest_unset(2) == 0);
+}
+
+TEST_CASE("sharded atomic_bitset puts each word on its own cache line",
+          "[atomic_bitset]") {
+    constexpr auto line = stdx::detail::cache_line_size;
+    STATIC_REQUIRE(alignof(stdx::sharded_atomic_bitset<8>) == line);
+    STATIC_REQUIRE(sizeof(stdx::sharded_atomic_bitset<8>) == line);
+    STATIC_REQUIRE(sizeof(stdx::sharded_atomic_bitset<256>) == 4 * line);
+    STATIC_REQUIRE(
+        sizeof(stdx::atomic_bitset<512, std::uint64_t, stdx::no_snapshot,
+                                   stdx::sharded_layout<4>>) == 2 * line);
+}
+
+TEMPLATE_TEST_CASE("sharded atomic_bitset operations", "[atomic_bitset]",
+                   std::uint8_t, std::uint64_t) {
+    using namespace stdx::literals;
+    using bitset_t = stdx::bitset<150, TestType>;
+    auto bs = stdx::sharded_atomic_bitset<150, TestType>{stdx::place_bits, 3,
+                                                         149};
+    CHECK(bs.load() == bitset_t{stdx::place_bits, 3, 149});
+    bs.set(10_lsb, 140_msb);
+    auto expected = bitset_t{stdx::place_bits, 3, 149};
+    expected.set(10_lsb, 140_msb);
+    CHECK(bs.load() == expected);
+    CHECK(bs.count() == expected.count());
+    CHECK(bs.acquire_lowest_unset() == 0);
+    bs.store(bitset_t{});
+    CHECK(bs.none());
+}
+
+TEST_CASE("sharded atomic_bitset updated from several threads",
+          "[atomic_bitset]") {
+    auto bs = stdx::sharded_atomic_bitset<256>{};
+    auto work = [&](std::size_t word) {
+        for (auto i = 0; i < 1000; ++i) {
+            bs.flip(word * 64 + static_cast<std::size_t>(i) % 64,
+                    std::memory_order_relaxed);
+        }
+    };
+    auto t1 = std::thread(work, 0u);
+    auto t2 = std::thread(work, 3u);
+    t1.join();
+    t2.join();
+    // bits 40-63 of each word were flipped an odd number of times
+    CHECK(bs.count() == 2 * 24);
+}
+
+TEST_CASE("wait_any returns when a bit in the mask is already set",
+          "[atomic_bitset]") {
+    auto bs = stdx::atomic_bitset<8>{0b100ul};
+    CHECK(bs.wait_any(stdx::bitset<8>{0b110ul}) == stdx::bitset<8>{0b100ul});
+    CHECK(bs.wait_all(stdx::bitset<8>{0b100ul}) == stdx::bitset<8>{0b100ul});
+}
+
+TEST_CASE("wait_any blocks until a bit in the mask is set",
+          "[atomic_bitset]") {
+    auto bs = stdx::atomic_bitset<8>{};
+    auto t = std::thread([&] {
+        auto const v = bs.wait_any(stdx::bitset<8>{0b110ul});
+        CHECK(v[2]);
+    });
+    bs.set(0);
+    bs.notify_all();
+    bs.set(2);
+    bs.notify_all();
+    t.join();
+}
+
+TEST_CASE("wait_all blocks until every bit in the mask is set",
+          "[atomic_bitset]") {
+    auto bs = stdx::atomic_bitset<8>{};
+    auto t = std::thread([&] {
+        auto const v = bs.wait_all(stdx::bitset<8>{0b11ul});
+        CHECK(v[0]);
+        CHECK(v[1]);
+    });
+    bs.set(0);
+    bs.notify_one();
+    bs.set(1);
+    bs.notify_one();
+    t.join();
+}
+
+TEST_CASE("multi-word wait", "[atomic_bitset]") {
+    using bitset_t = stdx::bitset<200, std::uint64_t>;
+    auto bs = stdx::atomic_bitset<200, std::uint64_t>{};
+    auto t1 = std::thread([&] {
+        auto const v = bs.wait_any(bitset_t{stdx::place_bits, 10, 150});
+        CHECK((v[10] or v[150]));
+    });
+    auto t2 = std::thread([&] {
+        auto const v = bs.wait_all(bitset_t{stdx::place_bits, 10, 150});
+        CHECK(v[10]);
+        CHECK(v[150]);
+    });
+    bs.set(150);
+    bs.notify_one();
+    bs.set(10);
+    bs.notify_all();
+    t1.join();
+    t2.join();
+}
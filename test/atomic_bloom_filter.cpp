@@ -0,0 +1,53 @@
+#include <stdx/atomic_bloom_filter.hpp>
+#include <stdx/bloom_filter.hpp>
+#include <stdx/span.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <thread>
+
+TEST_CASE("atomic_bloom_filter contains what was inserted",
+          "[atomic_bloom_filter]") {
+    auto f = stdx::atomic_bloom_filter<1024, 4>{};
+    CHECK(not f.may_contain(7u));
+    for (auto i = 0u; i < 50u; ++i) {
+        f.insert(i * 7u);
+    }
+    for (auto i = 0u; i < 50u; ++i) {
+        CHECK(f.may_contain(i * 7u));
+    }
+    f.clear();
+    CHECK(not f.may_contain(7u));
+}
+
+TEST_CASE("atomic_bloom_filter agrees with bloom_filter",
+          "[atomic_bloom_filter]") {
+    static constexpr auto keys = std::array{3u, 1u, 4u, 1u, 5u, 9u, 2u, 6u};
+    constexpr auto f = stdx::bloom_filter<512, 3>{stdx::span{keys}};
+    auto const af = stdx::atomic_bloom_filter<512, 3>{f};
+    for (auto i = 0u; i < 100u; ++i) {
+        CHECK(af.may_contain(i) == f.may_contain(i));
+    }
+
+    auto results = std::array<bool, 8>{};
+    CHECK(af.may_contain(stdx::span{keys}, stdx::span{results}) == 8);
+}
+
+TEST_CASE("atomic_bloom_filter concurrent inserts", "[atomic_bloom_filter]") {
+    auto f = stdx::atomic_bloom_filter<4096, 4>{};
+    auto keys_a = std::array<std::uint32_t, 100>{};
+    auto keys_b = std::array<std::uint32_t, 100>{};
+    for (auto i = 0u; i < 100u; ++i) {
+        keys_a[i] = i;
+        keys_b[i] = i + 1000u;
+    }
+    auto t = std::thread{[&] { f.insert(stdx::span{keys_a}); }};
+    f.insert(stdx::span{keys_b});
+    t.join();
+    for (auto i = 0u; i < 100u; ++i) {
+        CHECK(f.may_contain(keys_a[i]));
+        CHECK(f.may_contain(keys_b[i]));
+    }
+}
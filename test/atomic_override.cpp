@@ -2,9 +2,29 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <atomic>
 #include <cstdint>
 #include <type_traits>
 
+namespace {
+// a platform that overrides the ::atomic accesses injects matching
+// compare-exchange and waiting
+struct counting_policy : stdx::default_atomic_policy {
+    int compare_exchanges{};
+
+    template <typename T>
+    auto compare_exchange(T &t, T &expected, T desired, bool weak,
+                          std::memory_order success,
+                          std::memory_order failure) -> bool {
+        ++compare_exchanges;
+        return stdx::default_atomic_policy::compare_exchange(
+            t, expected, desired, weak, success, failure);
+    }
+};
+} // namespace
+
+template <> inline auto stdx::atomic_policy<> = counting_policy{};
+
 TEST_CASE("atomic with overridden type is correctly sized/aligned",
           "[atomic_override]") {
     auto bs = stdx::atomic<bool>{};
@@ -40,3 +60,26 @@ TEST_CASE("atomic config works with enum", "[atomic_override]") {
     STATIC_REQUIRE(sizeof(decltype(bs)) == sizeof(std::uint32_t));
     STATIC_REQUIRE(alignof(decltype(bs)) == alignof(std::uint32_t));
 }
+
+TEST_CASE("compare_exchange works with overridden type",
+          "[atomic_override]") {
+    auto bs = stdx::atomic<bool>{};
+    auto expected = true;
+    CHECK(not bs.compare_exchange_strong(expected, false));
+    CHECK(not expected);
+    CHECK(bs.compare_exchange_strong(expected, true));
+    CHECK(bs);
+    CHECK(bs.fetch_update([](bool b) { return not b; }));
+    CHECK(not bs);
+}
+
+TEST_CASE("compare_exchange goes through the injected policy",
+          "[atomic_override]") {
+    auto bs = stdx::atomic<bool>{};
+    auto const before = stdx::atomic_policy<>.compare_exchanges;
+    auto expected = false;
+    CHECK(bs.compare_exchange_strong(expected, true));
+    CHECK(stdx::atomic_policy<>.compare_exchanges == before + 1);
+    CHECK(bs.fetch_update([](bool b) { return not b; }));
+    CHECK(stdx::atomic_policy<>.compare_exchanges == before + 2);
+}
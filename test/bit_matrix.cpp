@@ -0,0 +1,165 @@
+#include "detail/pseudo_random.hpp"
+
+#include <stdx/bit_matrix.hpp>
+#include <stdx/bitset.hpp>
+#include <stdx/detail/simd.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+template <typename M>
+constexpr auto pseudo_random_matrix(std::uint64_t seed) -> M {
+    auto m = M{};
+    auto next = pseudo_random{seed};
+    for (auto r = std::size_t{}; r < m.num_rows; ++r) {
+        for (auto c = std::size_t{}; c < m.num_cols; ++c) {
+            m.set(r, c, next() % 4u == 0u);
+        }
+    }
+    return m;
+}
+
+template <typename M> constexpr auto naive_transpose(M const &m) {
+    auto t = stdx::bit_matrix<m.num_cols, m.num_rows>{};
+    for (auto r = std::size_t{}; r < m.num_rows; ++r) {
+        for (auto c = std::size_t{}; c < m.num_cols; ++c) {
+            t.set(c, r, m.get(r, c));
+        }
+    }
+    return t;
+}
+
+template <typename M> constexpr auto naive_closure(M m) {
+    for (auto n = std::size_t{}; n < m.num_rows; ++n) {
+        for (auto i = std::size_t{}; i < m.num_rows; ++i) {
+            for (auto j = std::size_t{}; j < m.num_rows; ++j) {
+                for (auto k = std::size_t{}; k < m.num_rows; ++k) {
+                    if (m.get(i, k) and m.get(k, j)) {
+                        m.set(i, j);
+                    }
+                }
+            }
+        }
+    }
+    return m;
+}
+} // namespace
+
+TEST_CASE("bit_matrix get and set", "[bit_matrix]") {
+    constexpr auto m = [] {
+        auto r = stdx::bit_matrix<3, 5>{};
+        r.set(0, 4).set(2, 1);
+        return r;
+    }();
+    STATIC_REQUIRE(m.get(0, 4));
+    STATIC_REQUIRE(m.get(2, 1));
+    STATIC_REQUIRE(not m.get(1, 1));
+    STATIC_REQUIRE(m.row(0) == decltype(m)::row_t{0b1'0000ul});
+}
+
+TEST_CASE("bit_matrix identity", "[bit_matrix]") {
+    constexpr auto id = stdx::bit_matrix<70, 70>::identity();
+    STATIC_REQUIRE(id.get(0, 0));
+    STATIC_REQUIRE(id.get(69, 69));
+    STATIC_REQUIRE(not id.get(0, 69));
+    STATIC_REQUIRE(id.transpose() == id);
+}
+
+TEST_CASE("64x64 tile transpose", "[bit_matrix]") {
+    auto tile = std::array<std::uint64_t, 64>{};
+    for (auto r = std::size_t{}; r < 64; ++r) {
+        tile[r] = std::uint64_t{0x9e37'79b9'7f4a'7c15u} * (r + 1);
+    }
+    auto expected = std::array<std::uint64_t, 64>{};
+    for (auto r = std::size_t{}; r < 64; ++r) {
+        for (auto c = std::size_t{}; c < 64; ++c) {
+            expected[c] |= ((tile[r] >> c) & 1u) << r;
+        }
+    }
+    stdx::detail::simd::transpose64(std::data(tile));
+    CHECK(tile == expected);
+}
+
+TEST_CASE("bit_matrix transpose", "[bit_matrix]") {
+    using m_t = stdx::bit_matrix<100, 150>;
+    static constexpr auto m = pseudo_random_matrix<m_t>(1u);
+    STATIC_REQUIRE(m.transpose() == naive_transpose(m));
+    STATIC_REQUIRE(m.transpose().transpose() == m);
+    auto const x = m;
+    CHECK(x.transpose() == naive_transpose(m));
+}
+
+TEST_CASE("bit_matrix transpose ignores unused row bits", "[bit_matrix]") {
+    auto m = stdx::bit_matrix<3, 3>{};
+    m.row(0) = ~m.row(0);
+    auto const t = m.transpose();
+    CHECK(t.get(0, 0));
+    CHECK(t.get(1, 0));
+    CHECK(t.get(2, 0));
+    CHECK(t.row(0).count() == 1);
+    CHECK(t.row(1).count() == 1);
+    CHECK(t.row(2).count() == 1);
+}
+
+TEST_CASE("bit_matrix or_rows", "[bit_matrix]") {
+    constexpr auto m = [] {
+        auto r = stdx::bit_matrix<4, 8>{};
+        r.set(0, 0).set(1, 1).set(2, 2).set(3, 3);
+        return r;
+    }();
+    constexpr auto acc = m.or_rows(stdx::bitset<4>{0b1010ul});
+    STATIC_REQUIRE(acc == decltype(m)::row_t{0b1010ul});
+}
+
+TEST_CASE("bit_matrix multiply", "[bit_matrix]") {
+    using a_t = stdx::bit_matrix<20, 30>;
+    using b_t = stdx::bit_matrix<30, 10>;
+    static constexpr auto a = pseudo_random_matrix<a_t>(2u);
+    static constexpr auto b = pseudo_random_matrix<b_t>(3u);
+    constexpr auto expected = [] {
+        auto r = stdx::bit_matrix<20, 10>{};
+        for (auto i = std::size_t{}; i < 20; ++i) {
+            for (auto j = std::size_t{}; j < 10; ++j) {
+                for (auto k = std::size_t{}; k < 30; ++k) {
+                    if (a.get(i, k) and b.get(k, j)) {
+                        r.set(i, j);
+                    }
+                }
+            }
+        }
+        return r;
+    }();
+    STATIC_REQUIRE(a * b == expected);
+    auto const x = a;
+    CHECK(x * b == expected);
+}
+
+TEST_CASE("bit_matrix transitive closure at compile time", "[bit_matrix]") {
+    // 0 -> 1 -> 2 -> 3, 4 -> 4
+    constexpr auto m = [] {
+        auto r = stdx::bit_matrix<5, 5>{};
+        r.set(0, 1).set(1, 2).set(2, 3).set(4, 4);
+        return r;
+    }();
+    constexpr auto c = m.transitive_closure();
+    STATIC_REQUIRE(c.get(0, 3));
+    STATIC_REQUIRE(c.get(1, 3));
+    STATIC_REQUIRE(not c.get(3, 0));
+    STATIC_REQUIRE(not c.get(0, 0));
+    STATIC_REQUIRE(c.get(4, 4));
+    STATIC_REQUIRE(c.row(0).count() == 3);
+}
+
+TEST_CASE("bit_matrix transitive closure", "[bit_matrix]") {
+    using m_t = stdx::bit_matrix<40, 40>;
+    auto m = m_t{};
+    auto next = pseudo_random{4u};
+    for (auto r = std::size_t{}; r < 40; ++r) {
+        m.set(r, next() % 40u);
+    }
+    CHECK(m.transitive_closure() == naive_closure(m));
+}
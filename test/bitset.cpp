@@ -1,11 +1,19 @@
+#include "detail/pseudo_random.hpp"
+
 #include <stdx/bitset.hpp>
 
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <limits>
+#include <ranges>
 #include <type_traits>
+#include <vector>
 
 TEST_CASE("bitset storage rounds up to nearest element size", "[bitset]") {
     STATIC_REQUIRE(sizeof(stdx::bitset<1, std::uint8_t>) == 1);
@@ -568,3 +576,420 @@ TEST_CASE("zero size bitset", "[bitset]") {
     bs3 = stdx::bitset<0>{stdx::all_bits};
     CHECK(bs3.to<std::uint8_t>() == 0);
 }
+
+namespace {
+template <typename A, typename BS>
+auto same_bits(A const &actual, BS const &expected) -> bool {
+    for (auto i = std::size_t{}; i < actual.capacity(); ++i) {
+        if (actual[i] != expected[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("large bitset bulk operations match constexpr results",
+                   "[bitset]", std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    using bs_t = stdx::bitset<1000, TestType>;
+    constexpr auto a = pseudo_random_bitset<bs_t>(0x1234'5678'9abc'def0u);
+    constexpr auto b = pseudo_random_bitset<bs_t>(0x0fed'cba9'8765'4321u);
+    auto const x = a;
+    auto const y = b;
+
+    constexpr bs_t or_result = a | b;
+    constexpr bs_t and_result = a & b;
+    constexpr bs_t xor_result = a ^ b;
+    constexpr auto not_result = ~a;
+    constexpr bs_t diff_result = a - b;
+    CHECK(same_bits(x | y, or_result));
+    CHECK(same_bits(x & y, and_result));
+    CHECK(same_bits(x ^ y, xor_result));
+    CHECK(same_bits(~x, not_result));
+    CHECK(same_bits(x - y, diff_result));
+
+    constexpr auto count = a.count();
+    CHECK(x.count() == count);
+
+    CHECK(x == a);
+    CHECK(x != y);
+    auto z = x;
+    z.flip(999);
+    CHECK(z != x);
+    z.flip(999);
+    z.flip(0);
+    CHECK(z != x);
+}
+
+TEMPLATE_TEST_CASE("large bitset shifts match constexpr results", "[bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    using bs_t = stdx::bitset<1000, TestType>;
+    static constexpr auto a =
+        pseudo_random_bitset<bs_t>(0x1234'5678'9abc'def0u);
+    auto const x = a;
+
+    static constexpr auto shifts =
+        std::array<std::size_t, 9>{0, 1, 7, 31, 63, 64, 65, 200, 999};
+    constexpr auto left = [] {
+        auto r = std::array<bs_t, std::size(shifts)>{};
+        for (auto i = std::size_t{}; i < std::size(shifts); ++i) {
+            r[i] = a << shifts[i];
+        }
+        return r;
+    }();
+    constexpr auto right = [] {
+        auto r = std::array<bs_t, std::size(shifts)>{};
+        for (auto i = std::size_t{}; i < std::size(shifts); ++i) {
+            r[i] = a >> shifts[i];
+        }
+        return r;
+    }();
+
+    for (auto i = std::size_t{}; i < std::size(shifts); ++i) {
+        CHECK(same_bits(x << shifts[i], left[i]));
+        CHECK(same_bits(x >> shifts[i], right[i]));
+    }
+}
+
+TEMPLATE_TEST_CASE("right shift does not shift in bits beyond the size",
+                   "[bitset]", std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    constexpr auto bs = ~stdx::bitset<3, TestType>{} >> 1;
+    STATIC_REQUIRE(bs == stdx::bitset<3, TestType>{0b11ul});
+}
+
+TEMPLATE_TEST_CASE("transform_reduce ignores bits beyond the size", "[bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    constexpr auto bs = ~stdx::bitset<3, TestType>{};
+    STATIC_REQUIRE(transform_reduce([](auto) { return 1; }, std::plus{}, 0,
+                                    bs) == 3);
+}
+
+TEMPLATE_TEST_CASE("decode set bits into a span", "[bitset]", std::uint8_t,
+                   std::uint16_t, std::uint32_t, std::uint64_t) {
+    using bs_t = stdx::bitset<1000, TestType>;
+    auto const bs = ~pseudo_random_bitset<bs_t>(0x1234'5678'9abc'def0u);
+    auto expected = std::vector<std::uint16_t>{};
+    for_each([&](auto i) { expected.push_back(static_cast<std::uint16_t>(i)); },
+             bs);
+
+    auto buffer = std::array<std::uint16_t, 1000>{};
+    auto const n = bs.decode_set_bits(stdx::span{buffer});
+    REQUIRE(n == bs.count());
+    CHECK(std::vector<std::uint16_t>(std::cbegin(buffer),
+                                     std::cbegin(buffer) + n) == expected);
+}
+
+TEMPLATE_TEST_CASE("decode set bits in batches", "[bitset]", std::uint8_t,
+                   std::uint16_t, std::uint32_t, std::uint64_t) {
+    using bs_t = stdx::bitset<1000, TestType>;
+    auto const bs = pseudo_random_bitset<bs_t>(0x0fed'cba9'8765'4321u);
+    auto expected = std::vector<std::uint32_t>{};
+    for_each([&](auto i) { expected.push_back(static_cast<std::uint32_t>(i)); },
+             bs);
+
+    for (auto batch : {1u, 7u, 37u, 64u, 100u}) {
+        auto buffer = std::vector<std::uint32_t>(batch);
+        auto decoded = std::vector<std::uint32_t>{};
+        auto pos = std::size_t{};
+        while (true) {
+            auto const n = bs.decode_set_bits(stdx::span{buffer}, pos);
+            auto const first = std::cbegin(buffer);
+            decoded.insert(std::cend(decoded), first,
+                           first + static_cast<std::ptrdiff_t>(n));
+            if (n < buffer.size()) {
+                break;
+            }
+            pos = buffer[n - 1] + 1;
+        }
+        CHECK(decoded == expected);
+    }
+}
+
+TEST_CASE("decode set bits ignores bits beyond the size", "[bitset]") {
+    constexpr auto bs = ~stdx::bitset<3>{};
+    auto buffer = std::array<std::uint8_t, 8>{};
+    CHECK(bs.decode_set_bits(stdx::span{buffer}) == 3);
+    CHECK(bs.decode_set_bits(stdx::span{buffer}, 2) == 1);
+    CHECK(buffer[0] == 2);
+}
+
+TEST_CASE("decode set bits is constexpr", "[bitset]") {
+    constexpr auto sum = [] {
+        constexpr auto bs =
+            stdx::bitset<200>{stdx::place_bits, 3, 64, 65, 130, 199};
+        auto buffer = std::array<std::uint8_t, 200>{};
+        auto const n = bs.decode_set_bits(stdx::span{buffer});
+        auto r = std::size_t{};
+        for (auto i = std::size_t{}; i < n; ++i) {
+            r += buffer[i];
+        }
+        return r;
+    }();
+    STATIC_REQUIRE(sum == 461);
+}
+
+TEMPLATE_TEST_CASE("find first and last set bits", "[bitset]", std::uint8_t,
+                   std::uint16_t, std::uint32_t, std::uint64_t) {
+    constexpr auto bs = stdx::bitset<300, TestType>{stdx::place_bits, 5, 64,
+                                                    65, 200};
+    STATIC_REQUIRE(bs.find_first() == 5);
+    STATIC_REQUIRE(bs.find_last() == 200);
+    STATIC_REQUIRE(bs.template find_first<stdx::unset_bit>() == 0);
+    STATIC_REQUIRE(bs.template find_last<stdx::unset_bit>() == 299);
+
+    constexpr auto empty = stdx::bitset<300, TestType>{};
+    STATIC_REQUIRE(empty.find_first() == 300);
+    STATIC_REQUIRE(empty.find_last() == 300);
+    STATIC_REQUIRE((~empty).template find_first<stdx::unset_bit>() == 300);
+    STATIC_REQUIRE((~empty).template find_last<stdx::unset_bit>() == 300);
+}
+
+TEMPLATE_TEST_CASE("find next and previous set bits", "[bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    constexpr auto bs = stdx::bitset<300, TestType>{stdx::place_bits, 5, 64,
+                                                    65, 200};
+    STATIC_REQUIRE(bs.find_next(0) == 5);
+    STATIC_REQUIRE(bs.find_next(5) == 64);
+    STATIC_REQUIRE(bs.find_next(64) == 65);
+    STATIC_REQUIRE(bs.find_next(65) == 200);
+    STATIC_REQUIRE(bs.find_next(200) == 300);
+    STATIC_REQUIRE(bs.find_next(1000) == 300);
+
+    STATIC_REQUIRE(bs.find_prev(299) == 200);
+    STATIC_REQUIRE(bs.find_prev(200) == 65);
+    STATIC_REQUIRE(bs.find_prev(65) == 64);
+    STATIC_REQUIRE(bs.find_prev(64) == 5);
+    STATIC_REQUIRE(bs.find_prev(5) == 300);
+    STATIC_REQUIRE(bs.find_prev(0) == 300);
+
+    STATIC_REQUIRE(bs.template find_next<stdx::unset_bit>(4) == 6);
+    STATIC_REQUIRE(bs.template find_prev<stdx::unset_bit>(66) == 63);
+}
+
+TEMPLATE_TEST_CASE("find ignores bits beyond the size", "[bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    constexpr auto bs = ~stdx::bitset<3, TestType>{};
+    STATIC_REQUIRE(bs.find_last() == 2);
+    STATIC_REQUIRE(bs.find_next(2) == 3);
+    STATIC_REQUIRE(bs.template find_first<stdx::unset_bit>() == 3);
+}
+
+TEMPLATE_TEST_CASE("iterate set bits as a range", "[bitset]", std::uint8_t,
+                   std::uint16_t, std::uint32_t, std::uint64_t) {
+    using bs_t = stdx::bitset<1000, TestType>;
+    auto const bs = pseudo_random_bitset<bs_t>(0x1234'5678'9abc'def0u);
+    auto expected = std::vector<std::size_t>{};
+    for_each([&](auto i) { expected.push_back(i); }, bs);
+
+    auto const r = bs.set_bits();
+    STATIC_REQUIRE(std::ranges::bidirectional_range<decltype(r)>);
+    CHECK(std::vector<std::size_t>(std::begin(r), std::end(r)) == expected);
+    CHECK(static_cast<std::size_t>(std::ranges::distance(r)) == bs.count());
+
+    auto reversed = std::vector<std::size_t>{};
+    for (auto i : r | std::views::reverse) {
+        reversed.push_back(i);
+    }
+    std::reverse(std::begin(reversed), std::end(reversed));
+    CHECK(reversed == expected);
+}
+
+TEST_CASE("iterate unset bits as a range", "[bitset]") {
+    constexpr auto bs = ~stdx::bitset<100>{stdx::place_bits, 3, 64, 99};
+    auto v = std::vector<std::size_t>{};
+    for (auto i : bs.unset_bits()) {
+        v.push_back(i);
+    }
+    CHECK(v == std::vector<std::size_t>{3, 64, 99});
+}
+
+TEST_CASE("set bit range can stop early", "[bitset]") {
+    constexpr static auto bs =
+        stdx::bitset<200>{stdx::place_bits, 3, 64, 150, 199};
+    constexpr auto r = bs.set_bits();
+    STATIC_REQUIRE(*std::ranges::find_if(r, [](auto i) { return i > 100; }) ==
+                   150);
+    STATIC_REQUIRE(*std::prev(std::end(r)) == 199);
+}
+
+TEST_CASE("set bit range with enum struct", "[bitset]") {
+    constexpr auto bs =
+        stdx::bitset<Bits::MAX>{stdx::place_bits, Bits::ONE, Bits::THREE};
+    auto v = std::vector<Bits>{};
+    for (auto b : bs.set_bits()) {
+        v.push_back(b);
+    }
+    CHECK(v == std::vector<Bits>{Bits::ONE, Bits::THREE});
+}
+
+TEST_CASE("bitset binary operators are eager", "[bitset]") {
+    using bs_t = stdx::bitset<8>;
+    auto a = bs_t{0b1100'1100ul};
+    auto const b = bs_t{0b1010'1010ul};
+    STATIC_REQUIRE(std::is_same_v<decltype(a | b), bs_t>);
+    STATIC_REQUIRE(std::is_same_v<decltype(a - b), bs_t>);
+    CHECK((a | b).to<std::uint8_t>() == 0b1110'1110u);
+    CHECK((a & b).lowest_unset() == 0);
+
+    stdx::bitset c = a ^ b;
+    STATIC_REQUIRE(std::is_same_v<decltype(c), bs_t>);
+    c.set(0);
+    CHECK(c == bs_t{0b0110'0111ul});
+
+    auto d = a | b;
+    a.reset();
+    CHECK(d == bs_t{0b1110'1110ul});
+}
+
+TEST_CASE("lazy starts a bitset expression", "[bitset]") {
+    using bs_t = stdx::bitset<8>;
+    auto const a = bs_t{0b1100'1100ul};
+    auto const b = bs_t{0b1010'1010ul};
+    STATIC_REQUIRE(not std::is_same_v<decltype(stdx::lazy(a) | b), bs_t>);
+    STATIC_REQUIRE(not std::is_same_v<decltype(a | stdx::lazy(b)), bs_t>);
+    STATIC_REQUIRE(
+        std::is_convertible_v<decltype(stdx::lazy(a) | b), bs_t>);
+    bs_t const c = stdx::lazy(a) | b;
+    CHECK(c == bs_t{0b1110'1110ul});
+    stdx::bitset d = stdx::lazy(a) & b;
+    STATIC_REQUIRE(std::is_same_v<decltype(d), bs_t>);
+    CHECK(d == bs_t{0b1000'1000ul});
+}
+
+TEMPLATE_TEST_CASE("compound bitset expression evaluates in one pass",
+                   "[bitset]", std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    using bs_t = stdx::bitset<1000, TestType>;
+    static constexpr auto a = pseudo_random_bitset<bs_t>(1u);
+    static constexpr auto b = pseudo_random_bitset<bs_t>(2u);
+    static constexpr auto c = pseudo_random_bitset<bs_t>(3u);
+    static constexpr auto d = pseudo_random_bitset<bs_t>(4u);
+
+    auto const expected = (a & b) - (c | d);
+
+    constexpr bs_t cx_result = (stdx::lazy(a) & b) - (stdx::lazy(c) | d);
+    CHECK(cx_result == expected);
+    auto const x = a;
+    bs_t result = (stdx::lazy(x) & b) - (stdx::lazy(c) | d);
+    CHECK(result == expected);
+    CHECK((stdx::lazy(x) & b) - (stdx::lazy(c) | d) == expected);
+}
+
+TEMPLATE_TEST_CASE("bitset expressions can be queried without evaluation",
+                   "[bitset]", std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    using bs_t = stdx::bitset<1000, TestType>;
+    static constexpr auto a = pseudo_random_bitset<bs_t>(5u);
+    static constexpr auto b = pseudo_random_bitset<bs_t>(6u);
+    auto const both = a & b;
+
+    STATIC_REQUIRE((stdx::lazy(a) & b).count() == (a & b).count());
+    auto const x = a;
+    CHECK((stdx::lazy(x) & b).count() == both.count());
+    CHECK((stdx::lazy(x) & b).any());
+    CHECK(not(stdx::lazy(x) & b).none());
+    CHECK(not(stdx::lazy(x) & b).all());
+    CHECK((stdx::lazy(x) - x).none());
+    CHECK((stdx::lazy(x) | ~x).all());
+    CHECK((stdx::lazy(x) ^ b)[17] == (a[17] != b[17]));
+
+    auto bits = std::vector<std::size_t>{};
+    stdx::for_each([&](auto i) { bits.push_back(i); }, stdx::lazy(x) & b);
+    auto expected = std::vector<std::size_t>{};
+    stdx::for_each([&](auto i) { expected.push_back(i); }, both);
+    CHECK(bits == expected);
+
+    CHECK(stdx::transform_reduce([](auto i) { return i; }, std::plus{},
+                                 std::size_t{}, stdx::lazy(x) & b) ==
+          stdx::transform_reduce([](auto i) { return i; }, std::plus{},
+                                 std::size_t{}, both));
+}
+
+TEST_CASE("bitset expression ignores bits beyond the size", "[bitset]") {
+    using bs_t = stdx::bitset<3, std::uint8_t>;
+    auto const a = bs_t{0b101ul};
+    CHECK((~a | stdx::lazy(a)).count() == 3);
+    CHECK((~a ^ stdx::lazy(a)).all());
+    CHECK((stdx::lazy(a) - a).none());
+}
+
+TEST_CASE("bitset expression holds temporaries by value", "[bitset]") {
+    using bs_t = stdx::bitset<16>;
+    auto const a = bs_t{0xff00ul};
+    auto const e = stdx::lazy(a) & bs_t{0x0ff0ul};
+    CHECK(e.count() == 4);
+    CHECK(bs_t{e} == bs_t{0x0f00ul});
+}
+
+TEMPLATE_TEST_CASE("intersection, union and difference counts", "[bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    using bs_t = stdx::bitset<1000, TestType>;
+    static constexpr auto a = pseudo_random_bitset<bs_t>(7u);
+    static constexpr auto b = pseudo_random_bitset<bs_t>(8u);
+    STATIC_REQUIRE(stdx::intersection_count(a, b) == (a & b).count());
+    STATIC_REQUIRE(stdx::union_count(a, b) == (a | b).count());
+    STATIC_REQUIRE(stdx::difference_count(a, b) == (a - b).count());
+
+    auto const x = a;
+    CHECK(stdx::intersection_count(x, b) == (a & b).count());
+    CHECK(stdx::union_count(x, b) == (a | b).count());
+    CHECK(stdx::difference_count(x, b) == (a - b).count());
+    CHECK(stdx::intersection_count(x, x) == x.count());
+    CHECK(stdx::difference_count(x, x) == 0);
+}
+
+TEMPLATE_TEST_CASE("count of a large bitset matches constexpr count",
+                   "[bitset]", std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    using bs_t = stdx::bitset<10'000, TestType>;
+    static constexpr auto a = pseudo_random_bitset<bs_t>(9u);
+    static constexpr auto b = pseudo_random_bitset<bs_t>(10u);
+    constexpr auto count = a.count();
+    constexpr auto both = stdx::intersection_count(a, b);
+    auto const x = a;
+    CHECK(x.count() == count);
+    CHECK(stdx::intersection_count(x, b) == both);
+    CHECK(x.count() == stdx::transform_reduce([](auto) { return 1u; },
+                                              std::plus{}, 0u, x));
+}
+
+TEMPLATE_TEST_CASE("total count of a span of bitsets", "[bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    using bs_t = stdx::bitset<512, TestType>;
+    static constexpr auto bss = [] {
+        auto r = std::array<bs_t, 40>{};
+        for (auto i = std::size_t{}; i < r.size(); ++i) {
+            r[i] = pseudo_random_bitset<bs_t>(i + 1);
+        }
+        return r;
+    }();
+    constexpr auto expected = [] {
+        auto n = std::size_t{};
+        for (auto const &bs : bss) {
+            n += bs.count();
+        }
+        return n;
+    }();
+    STATIC_REQUIRE(stdx::total_count(stdx::span{bss}) == expected);
+    auto const rt = bss;
+    CHECK(stdx::total_count(stdx::span{rt}) == expected);
+    CHECK(stdx::total_count(stdx::span{rt}.subspan(3, 20)) ==
+          stdx::total_count(stdx::span{bss}.subspan(3, 20)));
+}
+
+TEST_CASE("total count of bitsets with unused bits", "[bitset]") {
+    using bs_t = stdx::bitset<100, std::uint64_t>;
+    auto bss = std::array<bs_t, 3>{};
+    for (auto &bs : bss) {
+        bs = ~bs;
+    }
+    CHECK(stdx::total_count(stdx::span{bss}) == 300);
+}
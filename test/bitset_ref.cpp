@@ -0,0 +1,152 @@
+#include <stdx/bitset.hpp>
+#include <stdx/bitset_ref.hpp>
+#include <stdx/span.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+TEMPLATE_TEST_CASE("bitset_ref reads external words", "[bitset_ref]",
+                   std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    TestType words[8]{0b101u};
+    auto const r = stdx::bitset_ref<40, TestType const>{words};
+    CHECK(r[0]);
+    CHECK(not r[1]);
+    CHECK(r[2]);
+    CHECK(r.count() == 2);
+    CHECK(r.any());
+    CHECK(not r.all());
+    CHECK(r.lowest_unset() == 1);
+}
+
+TEMPLATE_TEST_CASE("bitset_ref modifies external words", "[bitset_ref]",
+                   std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    auto words = std::array<TestType, 16>{};
+    auto const r = stdx::bitset_ref<100, TestType>{words};
+    r.set(3).set(99);
+    CHECK(words[0] == 0b1000u);
+    CHECK(r.count() == 2);
+    r.flip(3);
+    CHECK(words[0] == 0);
+    r.reset(99);
+    CHECK(r.none());
+}
+
+TEST_CASE("bitset_ref over a span", "[bitset_ref]") {
+    auto words = std::vector<std::uint32_t>(10);
+    auto const r = stdx::bitset_ref<300, std::uint32_t>{stdx::span{words}};
+    r.set(299);
+    CHECK(words[9] == 1u << 11u);
+}
+
+TEST_CASE("bitset_ref over a bitset", "[bitset_ref]") {
+    auto bs = stdx::bitset<100>{};
+    auto const r = stdx::bitset_ref{bs};
+    r.set(42);
+    CHECK(bs[42]);
+
+    auto const &cbs = bs;
+    auto const cr = stdx::bitset_ref{cbs};
+    CHECK(cr[42]);
+    CHECK(cr.to_bitset() == bs);
+}
+
+TEST_CASE("bitset_ref never changes bits beyond the size", "[bitset_ref]") {
+    auto words = std::array<std::uint8_t, 2>{0, 0b1111'0000u};
+    auto const r = stdx::bitset_ref<12, std::uint8_t>{words};
+    r.set();
+    CHECK(words[1] == 0xffu);
+    CHECK(r.all());
+    r.reset();
+    CHECK(words[1] == 0b1111'0000u);
+    CHECK(r.none());
+    r.flip();
+    CHECK(words[1] == 0xffu);
+    r >>= 1;
+    CHECK(words[1] == 0b1111'0111u);
+    r <<= 4;
+    CHECK(words == std::array<std::uint8_t, 2>{0xf0u, 0xffu});
+    r ^= ~r.to_bitset();
+    CHECK(words == std::array<std::uint8_t, 2>{0xffu, 0xffu});
+}
+
+TEST_CASE("bitset_ref set and reset ranges", "[bitset_ref]") {
+    using namespace stdx::literals;
+    auto words = std::array<std::uint64_t, 4>{};
+    auto const r = stdx::bitset_ref<256, std::uint64_t>{words};
+    r.set(10_lsb, 200_msb);
+    CHECK(r.count() == 191);
+    r.reset(20_lsb, 10_len);
+    CHECK(r.count() == 181);
+    CHECK(r.find_first() == 10);
+    CHECK(r.find_next(19) == 30);
+    CHECK(r.find_last() == 200);
+}
+
+TEMPLATE_TEST_CASE("bitset_ref set algebra", "[bitset_ref]", std::uint8_t,
+                   std::uint16_t, std::uint32_t, std::uint64_t) {
+    using bs_t = stdx::bitset<200, TestType>;
+    auto a = bs_t{stdx::place_bits, 1, 2, 100, 199};
+    auto const b = bs_t{stdx::place_bits, 2, 3, 100};
+    auto const ra = stdx::bitset_ref{a};
+    auto const rb = stdx::bitset_ref{b};
+
+    CHECK((ra | rb) == bs_t{stdx::place_bits, 1, 2, 3, 100, 199});
+    CHECK((ra & rb) == bs_t{stdx::place_bits, 2, 100});
+    CHECK((ra ^ rb) == bs_t{stdx::place_bits, 1, 3, 199});
+    CHECK((ra - rb) == bs_t{stdx::place_bits, 1, 199});
+    CHECK((~ra).count() == 196);
+    CHECK(ra != rb);
+    CHECK(ra == a);
+
+    ra |= b;
+    CHECK(a == bs_t{stdx::place_bits, 1, 2, 3, 100, 199});
+    ra -= rb;
+    CHECK(a == bs_t{stdx::place_bits, 1, 199});
+    ra &= b;
+    CHECK(a.none());
+}
+
+TEMPLATE_TEST_CASE("bitset_ref for_each", "[bitset_ref]", std::uint8_t,
+                   std::uint16_t, std::uint32_t, std::uint64_t) {
+    auto const bs = stdx::bitset<200, TestType>{stdx::place_bits, 1, 64, 199};
+    auto const r = stdx::bitset_ref{bs};
+    auto v = std::vector<std::size_t>{};
+    for_each([&](auto i) { v.push_back(i); }, r);
+    CHECK(v == std::vector<std::size_t>{1, 64, 199});
+
+    auto n = std::size_t{};
+    for_each<stdx::unset_bit>([&](auto) { ++n; }, r);
+    CHECK(n == 197);
+
+    CHECK(transform_reduce([](auto i) { return i; }, std::plus{},
+                           std::size_t{}, r) == 264);
+
+    v.clear();
+    for (auto i : r.set_bits()) {
+        v.push_back(i);
+    }
+    CHECK(v == std::vector<std::size_t>{1, 64, 199});
+
+    auto buffer = std::array<std::uint8_t, 8>{};
+    CHECK(r.decode_set_bits(stdx::span{buffer}) == 3);
+    CHECK(buffer[2] == 199);
+}
+
+TEST_CASE("bitset_ref is constexpr", "[bitset_ref]") {
+    constexpr auto count = [] {
+        auto words = std::array<std::uint32_t, 4>{};
+        auto const r = stdx::bitset_ref<100, std::uint32_t>{words};
+        r.set(stdx::lsb_t{5}, stdx::msb_t{70});
+        r >>= 5;
+        return r.count() + words[0];
+    }();
+    STATIC_REQUIRE(count == 66 + std::size_t{0xffff'ffffu});
+}
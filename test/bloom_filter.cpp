@@ -0,0 +1,116 @@
+#include <stdx/bloom_filter.hpp>
+#include <stdx/span.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+TEST_CASE("bloom_filter contains what was inserted", "[bloom_filter]") {
+    auto f = stdx::bloom_filter<1024, 4>{};
+    for (auto i = 0u; i < 50u; ++i) {
+        f.insert(i * 7u);
+    }
+    for (auto i = 0u; i < 50u; ++i) {
+        CHECK(f.may_contain(i * 7u));
+    }
+}
+
+TEST_CASE("empty bloom_filter contains nothing", "[bloom_filter]") {
+    constexpr auto f = stdx::bloom_filter<512, 3>{};
+    STATIC_REQUIRE(not f.may_contain(42));
+    STATIC_REQUIRE(f.bits().none());
+}
+
+TEST_CASE("bloom_filter sets up to Hashes bits per key", "[bloom_filter]") {
+    auto f = stdx::bloom_filter<512, 5>{};
+    f.insert(17);
+    CHECK(f.bits().count() == 5);
+}
+
+TEST_CASE("bloom_filter false positive rate is reasonable",
+          "[bloom_filter]") {
+    // 8192 bits, 500 keys, 6 hashes: the expected rate is well under 1%
+    auto f = stdx::bloom_filter<8192, 6>{};
+    for (auto i = std::uint64_t{}; i < 500; ++i) {
+        f.insert(i);
+    }
+    auto false_positives = 0;
+    for (auto i = std::uint64_t{1'000'000}; i < 1'010'000; ++i) {
+        false_positives += f.may_contain(i) ? 1 : 0;
+    }
+    CHECK(false_positives < 200);
+}
+
+TEST_CASE("bloom_filter with string keys", "[bloom_filter]") {
+    using namespace std::string_view_literals;
+    auto f = stdx::bloom_filter<1024, 4>{};
+    f.insert("hello"sv);
+    f.insert("world"sv);
+    CHECK(f.may_contain("hello"sv));
+    CHECK(f.may_contain("world"sv));
+}
+
+namespace {
+enum struct color : std::uint8_t { red, green, blue };
+
+struct identity_hash {
+    constexpr auto operator()(std::uint64_t k) const -> std::uint64_t {
+        return k;
+    }
+};
+} // namespace
+
+TEST_CASE("bloom_filter with enum keys", "[bloom_filter]") {
+    auto f = stdx::bloom_filter<512, 2>{};
+    f.insert(color::green);
+    CHECK(f.may_contain(color::green));
+}
+
+TEST_CASE("bloom_filter with custom hash", "[bloom_filter]") {
+    auto f = stdx::bloom_filter<1024, 3, identity_hash>{};
+    f.insert(std::uint64_t{0xffff'ffff'0000'0000u});
+    CHECK(f.may_contain(std::uint64_t{0xffff'ffff'0000'0000u}));
+}
+
+TEST_CASE("bloom_filter batch insert and query", "[bloom_filter]") {
+    auto keys = std::array<std::uint32_t, 20>{};
+    for (auto i = std::size_t{}; i < keys.size(); ++i) {
+        keys[i] = static_cast<std::uint32_t>(i * 1000u);
+    }
+    auto f = stdx::bloom_filter<2048, 4>{};
+    f.insert(stdx::span{keys});
+
+    auto results = std::array<bool, 20>{};
+    CHECK(f.may_contain(stdx::span{keys}, stdx::span{results}) == 20);
+    for (auto r : results) {
+        CHECK(r);
+    }
+
+    auto single = stdx::bloom_filter<2048, 4>{};
+    for (auto k : keys) {
+        single.insert(k);
+    }
+    CHECK(single.bits() == f.bits());
+}
+
+TEST_CASE("bloom_filter built at compile time", "[bloom_filter]") {
+    static constexpr auto keys = std::array{3u, 1u, 4u, 1u, 5u, 9u, 2u, 6u};
+    constexpr auto f = stdx::bloom_filter<512, 3>{stdx::span{keys}};
+    STATIC_REQUIRE(f.may_contain(3u));
+    STATIC_REQUIRE(f.may_contain(9u));
+    STATIC_REQUIRE(f.bits().any());
+
+    auto rt = stdx::bloom_filter<512, 3>{};
+    rt.insert(stdx::span{keys});
+    CHECK(rt.bits() == f.bits());
+}
+
+TEST_CASE("bloom_filter clear", "[bloom_filter]") {
+    auto f = stdx::bloom_filter<512, 3>{};
+    f.insert(1);
+    f.clear();
+    CHECK(f.bits().none());
+}
@@ -0,0 +1,260 @@
+#include "detail/pseudo_random.hpp"
+
+#include <stdx/compressed_bitset.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <vector>
+
+namespace {
+auto to_vector(stdx::compressed_bitset const &bs) {
+    auto v = std::vector<std::uint32_t>{};
+    for_each([&](auto i) { v.push_back(i); }, bs);
+    return v;
+}
+
+auto to_vector(std::set<std::uint32_t> const &s) {
+    return std::vector<std::uint32_t>(std::cbegin(s), std::cend(s));
+}
+
+template <typename F> auto random_values(std::uint64_t seed, F &&f) {
+    auto next = pseudo_random{seed};
+    for (auto n = 0; n < 20'000; ++n) {
+        f(static_cast<std::uint32_t>(next()));
+    }
+}
+} // namespace
+
+TEST_CASE("compressed_bitset default construction", "[compressed_bitset]") {
+    auto const bs = stdx::compressed_bitset{};
+    CHECK(bs.none());
+    CHECK(bs.count() == 0);
+    CHECK(bs.storage_bytes() == 0);
+}
+
+TEST_CASE("compressed_bitset construct with placed bits",
+          "[compressed_bitset]") {
+    auto const bs =
+        stdx::compressed_bitset{stdx::place_bits, 1, 70'000, 4'000'000'000u};
+    CHECK(bs[1]);
+    CHECK(bs[70'000]);
+    CHECK(bs[4'000'000'000u]);
+    CHECK(not bs[2]);
+    CHECK(bs.count() == 3);
+    CHECK(to_vector(bs) ==
+          std::vector<std::uint32_t>{1, 70'000, 4'000'000'000u});
+}
+
+TEST_CASE("compressed_bitset set, reset and flip", "[compressed_bitset]") {
+    auto bs = stdx::compressed_bitset{};
+    bs.set(17).set(65'536);
+    CHECK(bs.count() == 2);
+    bs.reset(17);
+    CHECK(not bs[17]);
+    bs.flip(17).flip(65'536);
+    CHECK(to_vector(bs) == std::vector<std::uint32_t>{17});
+    bs.reset(17);
+    CHECK(bs.empty());
+    CHECK(bs.storage_bytes() == 0);
+}
+
+TEST_CASE("compressed_bitset converts between array and bitmap",
+          "[compressed_bitset]") {
+    auto bs = stdx::compressed_bitset{};
+    for (auto i = std::uint32_t{}; i < 10'000; ++i) {
+        bs.set(i * 2);
+    }
+    CHECK(bs.count() == 10'000);
+    CHECK(bs[19'998]);
+    CHECK(not bs[19'999]);
+    for (auto i = std::uint32_t{}; i < 9'000; ++i) {
+        bs.reset(i * 2);
+    }
+    CHECK(bs.count() == 1'000);
+    CHECK(bs[18'000]);
+    CHECK(not bs[17'998]);
+}
+
+TEST_CASE("compressed_bitset memory tracks cardinality",
+          "[compressed_bitset]") {
+    auto bs = stdx::compressed_bitset{};
+    for (auto i = std::uint32_t{}; i < 100; ++i) {
+        bs.set(i * 40'000'000u);
+    }
+    CHECK(bs.count() == 100);
+    CHECK(bs.storage_bytes() < 100 * 128);
+}
+
+TEST_CASE("compressed_bitset bitmaps shrink to arrays with hysteresis",
+          "[compressed_bitset]") {
+    auto bs = stdx::compressed_bitset{};
+    for (auto i = std::uint32_t{}; i <= 4096; ++i) {
+        bs.set(i * 2);
+    }
+    auto const bitmap_bytes = bs.storage_bytes();
+    for (auto n = 0; n < 10; ++n) {
+        bs.reset(8192);
+        CHECK(bs.storage_bytes() == bitmap_bytes);
+        bs.set(8192);
+        CHECK(bs.storage_bytes() == bitmap_bytes);
+    }
+    for (auto i = std::uint32_t{4096}; i >= 3584; --i) {
+        bs.reset(i * 2);
+    }
+    CHECK(bs.count() == 3584);
+    CHECK(bs.storage_bytes() < bitmap_bytes);
+    CHECK(bs[3583 * 2]);
+    CHECK(not bs[3584 * 2]);
+}
+
+TEST_CASE("compressed_bitset set and reset ranges", "[compressed_bitset]") {
+    using namespace stdx::literals;
+    auto bs = stdx::compressed_bitset{};
+    bs.set(100_lsb, 199'999_msb);
+    CHECK(bs.count() == 199'900);
+    CHECK(not bs[99]);
+    CHECK(bs[100]);
+    CHECK(bs[199'999]);
+    CHECK(not bs[200'000]);
+    bs.reset(1'000_lsb, 100'000_len);
+    CHECK(bs.count() == 99'900);
+    CHECK(bs[999]);
+    CHECK(not bs[1'000]);
+    CHECK(not bs[100'999]);
+    CHECK(bs[101'000]);
+}
+
+TEST_CASE("compressed_bitset optimize encodes runs", "[compressed_bitset]") {
+    auto bs = stdx::compressed_bitset{};
+    for (auto i = std::uint32_t{}; i < 60'000; ++i) {
+        bs.set(i);
+    }
+    auto const copy = bs;
+    auto const before = bs.storage_bytes();
+    bs.optimize();
+    CHECK(bs.storage_bytes() < before);
+    CHECK(bs == copy);
+    CHECK(bs.count() == 60'000);
+    CHECK(bs[59'999]);
+    CHECK(not bs[60'000]);
+    bs.set(60'001);
+    CHECK(bs.count() == 60'001);
+    CHECK(bs[60'001]);
+}
+
+TEST_CASE("compressed_bitset optimize measures a bitmap as a bitmap",
+          "[compressed_bitset]") {
+    auto bs = stdx::compressed_bitset{};
+    // 4000 members in 2020 runs: smaller as runs than as a bitmap, but not
+    // than as an array
+    for (auto i = std::uint32_t{}; i < 2020; ++i) {
+        bs.set(i * 4);
+        if (i < 1980) {
+            bs.set(i * 4 + 1);
+        }
+    }
+    // make a bitmap, then erase down to 4000 members, which stays a bitmap
+    for (auto i = std::uint32_t{}; i < 100; ++i) {
+        bs.set(60'000 + i * 2);
+    }
+    for (auto i = std::uint32_t{}; i < 100; ++i) {
+        bs.reset(60'000 + i * 2);
+    }
+    REQUIRE(bs.count() == 4000);
+    auto const copy = bs;
+    auto const before = bs.storage_bytes();
+    bs.optimize();
+    CHECK(bs.storage_bytes() < before);
+    CHECK(bs == copy);
+}
+
+TEST_CASE("compressed_bitset set algebra matches std::set",
+          "[compressed_bitset]") {
+    auto a = stdx::compressed_bitset{};
+    auto b = stdx::compressed_bitset{};
+    auto sa = std::set<std::uint32_t>{};
+    auto sb = std::set<std::uint32_t>{};
+    // clustered in a few chunks, so both arrays and bitmaps appear
+    random_values(2463534242u, [&](auto x) {
+        auto const v = x % 200'000u;
+        a.set(v);
+        sa.insert(v);
+    });
+    random_values(88675123u, [&](auto x) {
+        auto const v = (x % 3u == 0) ? x % 150'000u : x;
+        b.set(v);
+        sb.insert(v);
+    });
+    b.set(stdx::lsb_t{300'000}, stdx::msb_t{400'000});
+    for (auto v = std::uint32_t{300'000}; v <= 400'000; ++v) {
+        sb.insert(v);
+    }
+    CHECK(to_vector(a) == to_vector(sa));
+    CHECK(to_vector(b) == to_vector(sb));
+
+    auto expected = std::set<std::uint32_t>{};
+    std::set_union(std::cbegin(sa), std::cend(sa), std::cbegin(sb),
+                   std::cend(sb), std::inserter(expected, expected.end()));
+    CHECK(to_vector(a | b) == to_vector(expected));
+
+    expected.clear();
+    std::set_intersection(std::cbegin(sa), std::cend(sa), std::cbegin(sb),
+                          std::cend(sb),
+                          std::inserter(expected, expected.end()));
+    CHECK(to_vector(a & b) == to_vector(expected));
+    CHECK(intersection_count(a, b) == expected.size());
+    CHECK((a & b).count() == expected.size());
+
+    expected.clear();
+    std::set_symmetric_difference(std::cbegin(sa), std::cend(sa),
+                                  std::cbegin(sb), std::cend(sb),
+                                  std::inserter(expected, expected.end()));
+    CHECK(to_vector(a ^ b) == to_vector(expected));
+
+    expected.clear();
+    std::set_difference(std::cbegin(sa), std::cend(sa), std::cbegin(sb),
+                        std::cend(sb), std::inserter(expected, expected.end()));
+    CHECK(to_vector(a - b) == to_vector(expected));
+
+    a.optimize();
+    b.optimize();
+    CHECK(intersection_count(a, b) == (a & b).count());
+    CHECK(to_vector(a - b) == to_vector(expected));
+}
+
+TEST_CASE("compressed_bitset compound assignment", "[compressed_bitset]") {
+    auto a = stdx::compressed_bitset{stdx::place_bits, 1, 2, 100'000};
+    auto const b = stdx::compressed_bitset{stdx::place_bits, 2, 3};
+    auto c = a;
+    c |= b;
+    CHECK(c == stdx::compressed_bitset{stdx::place_bits, 1, 2, 3, 100'000});
+    c = a;
+    c &= b;
+    CHECK(c == stdx::compressed_bitset{stdx::place_bits, 2});
+    c = a;
+    c ^= b;
+    CHECK(c == stdx::compressed_bitset{stdx::place_bits, 1, 3, 100'000});
+    c = a;
+    c -= b;
+    CHECK(c == stdx::compressed_bitset{stdx::place_bits, 1, 100'000});
+    CHECK(a != b);
+}
+
+TEST_CASE("compressed_bitset transform_reduce", "[compressed_bitset]") {
+    auto const bs = stdx::compressed_bitset{stdx::place_bits, 1, 100'000};
+    CHECK(transform_reduce([](auto i) { return std::size_t{i}; },
+                           std::plus{}, std::size_t{}, bs) == 100'001);
+}
+
+TEST_CASE("compressed_bitset is constexpr", "[compressed_bitset]") {
+    constexpr auto count = [] {
+        auto a = stdx::compressed_bitset{stdx::place_bits, 1, 2, 70'000};
+        auto const b = stdx::compressed_bitset{stdx::place_bits, 2, 70'000};
+        return intersection_count(a, b) + (a | b).count();
+    }();
+    STATIC_REQUIRE(count == 5);
+}
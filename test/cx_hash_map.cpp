@@ -0,0 +1,203 @@
+#include "detail/pseudo_random.hpp"
+
+#include <stdx/cx_hash_map.hpp>
+#include <stdx/cx_map.hpp>
+#include <stdx/iterator.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace {
+// every key collides, so probes cross groups and erase leaves tombstones
+struct bad_hash {
+    template <typename K>
+    constexpr auto operator()(K const &) const -> std::uint64_t {
+        return 42;
+    }
+};
+
+template <typename M> constexpr auto sum_values(M const &m) {
+    auto sum = 0;
+    for (auto const &[k, v] : m) {
+        sum += v;
+    }
+    return sum;
+}
+} // namespace
+
+TEST_CASE("empty and size", "[cx_hash_map]") {
+    auto m = stdx::cx_hash_map<int, int, 64>{};
+    CHECK(m.size() == 0);
+    CHECK(m.empty());
+
+    CHECK(m.insert_or_assign(10, 50));
+    CHECK(m.size() == 1);
+    CHECK(not m.empty());
+}
+
+TEST_CASE("capacity", "[cx_hash_map]") {
+    auto m = stdx::cx_hash_map<int, int, 64>{};
+    STATIC_REQUIRE(m.capacity() == 64);
+    STATIC_REQUIRE(stdx::ct_capacity_v<decltype(m)> == 64);
+}
+
+TEST_CASE("contains and get", "[cx_hash_map]") {
+    auto m = stdx::cx_hash_map<int, int, 64>{};
+    CHECK(m.put(10, 50));
+    CHECK(m.put(11, 100));
+
+    REQUIRE(m.contains(10));
+    CHECK(m.get(10) == 50);
+    REQUIRE(m.contains(11));
+    CHECK(m.get(11) == 100);
+    CHECK(not m.contains(12));
+}
+
+TEST_CASE("update existing key", "[cx_hash_map]") {
+    auto m = stdx::cx_hash_map<int, int, 64>{};
+    CHECK(m.put(13, 500));
+    CHECK(not m.put(13, 700));
+    CHECK(m.size() == 1);
+    CHECK(m.get(13) == 700);
+}
+
+TEST_CASE("erase", "[cx_hash_map]") {
+    auto m = stdx::cx_hash_map<int, int, 64>{};
+    m.put(13, 500);
+    m.put(18, 600);
+    m.put(19, 700);
+
+    CHECK(m.erase(18) == 1u);
+    CHECK(m.erase(18) == 0u);
+    CHECK(m.size() == 2);
+    CHECK(not m.contains(18));
+    CHECK(m.get(13) == 500);
+    CHECK(m.get(19) == 700);
+}
+
+TEST_CASE("pop_back", "[cx_hash_map]") {
+    auto m = stdx::cx_hash_map<int, int, 64>{};
+    m.put(13, 500);
+    m.put(14, 600);
+
+    auto const entry = m.pop_back();
+    CHECK(m.size() == 1);
+    CHECK(entry.key == 14);
+    CHECK(entry.value == 600);
+    CHECK(not m.contains(14));
+    CHECK(m.get(13) == 500);
+}
+
+TEST_CASE("iteration is over the entries", "[cx_hash_map]") {
+    auto m = stdx::cx_hash_map<int, int, 64>{};
+    CHECK(m.begin() == m.end());
+    m.put(1, 10);
+    m.put(2, 20);
+    CHECK(std::distance(m.begin(), m.end()) == 2);
+    CHECK(sum_values(m) == 30);
+}
+
+TEST_CASE("clear", "[cx_hash_map]") {
+    auto m = stdx::cx_hash_map<int, int, 64>{};
+    m.put(1, 10);
+    m.clear();
+    CHECK(m.empty());
+    CHECK(not m.contains(1));
+    CHECK(m.put(1, 20));
+    CHECK(m.get(1) == 20);
+}
+
+TEST_CASE("construct from values", "[cx_hash_map]") {
+    using V = stdx::cx_map_value<int, int>;
+    auto const m = stdx::cx_hash_map<int, int, 4>{V{1, 10}, V{2, 20}};
+    CHECK(m.size() == 2);
+    CHECK(m.get(1) == 10);
+    CHECK(m.get(2) == 20);
+}
+
+TEST_CASE("string keys", "[cx_hash_map]") {
+    using namespace std::string_view_literals;
+    auto m = stdx::cx_hash_map<std::string_view, int, 8>{};
+    m.put("one"sv, 1);
+    m.put("two"sv, 2);
+    CHECK(m.get("one"sv) == 1);
+    CHECK(m.get("two"sv) == 2);
+    CHECK(not m.contains("three"sv));
+}
+
+TEST_CASE("constexpr populated map", "[cx_hash_map]") {
+    constexpr auto m = [] {
+        auto t = stdx::cx_hash_map<int, int, 64>{};
+        t.put(10, 50);
+        t.put(11, 100);
+        t.put(12, 150);
+        t.erase(12);
+        return t;
+    }();
+
+    STATIC_REQUIRE(m.size() == 2);
+    STATIC_REQUIRE(m.get(10) == 50);
+    STATIC_REQUIRE(m.get(11) == 100);
+    STATIC_REQUIRE(not m.contains(12));
+}
+
+TEST_CASE("full map with colliding keys", "[cx_hash_map]") {
+    constexpr auto N = std::size_t{40};
+    auto m = stdx::cx_hash_map<std::size_t, std::size_t, N, bad_hash>{};
+    for (auto i = std::size_t{}; i < N; ++i) {
+        CHECK(m.put(i, i * 2));
+    }
+    CHECK(m.full());
+    for (auto i = std::size_t{}; i < N; ++i) {
+        REQUIRE(m.contains(i));
+        CHECK(m.get(i) == i * 2);
+    }
+    CHECK(not m.contains(N));
+}
+
+TEST_CASE("erase and insert repeatedly with colliding keys",
+          "[cx_hash_map]") {
+    constexpr auto N = std::size_t{40};
+    auto m = stdx::cx_hash_map<std::size_t, std::size_t, N, bad_hash>{};
+    for (auto i = std::size_t{}; i < N; ++i) {
+        m.put(i, i);
+    }
+    // each round leaves tombstones, which are eventually rehashed away
+    for (auto i = N; i < 20 * N; ++i) {
+        REQUIRE(m.erase(i - N) == 1u);
+        REQUIRE(m.put(i, i));
+        REQUIRE(m.size() == N);
+    }
+    for (auto i = 19 * N; i < 20 * N; ++i) {
+        REQUIRE(m.contains(i));
+        CHECK(m.get(i) == i);
+    }
+    CHECK(not m.contains(19 * N - 1));
+}
+
+TEST_CASE("agrees with cx_map", "[cx_hash_map]") {
+    constexpr auto N = std::size_t{4096};
+    static auto expected = stdx::cx_map<std::uint32_t, std::uint32_t, N>{};
+    static auto actual = stdx::cx_hash_map<std::uint32_t, std::uint32_t, N>{};
+
+    auto next = pseudo_random{1u};
+    for (auto i = std::uint32_t{}; i < 50'000u; ++i) {
+        auto const k = static_cast<std::uint32_t>(next() % (2 * N));
+        if (next() % 3 == 0 or expected.full()) {
+            REQUIRE(actual.erase(k) == expected.erase(k));
+        } else {
+            REQUIRE(actual.put(k, i) == expected.put(k, i));
+        }
+        REQUIRE(actual.size() == expected.size());
+    }
+    for (auto k = std::uint32_t{}; k < 2 * N; ++k) {
+        REQUIRE(actual.contains(k) == expected.contains(k));
+        if (expected.contains(k)) {
+            CHECK(actual.get(k) == expected.get(k));
+        }
+    }
+}
@@ -1,7 +1,15 @@
 #include <stdx/cx_set.hpp>
 
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+enum struct E : std::uint16_t {};
+} // namespace
+
 TEST_CASE("empty and size", "[cx_set]") {
     auto s = stdx::cx_set<int, 64>{};
     CHECK(s.size() == 0);
@@ -112,3 +120,45 @@ TEST_CASE("constexpr erase", "[cx_set]") {
     STATIC_REQUIRE(not testSetRemove.contains(32));
     STATIC_REQUIRE(not testSetRemove.contains(56));
 }
+
+TEMPLATE_TEST_CASE("contains finds a key at any position", "[cx_set]",
+                   std::uint8_t, std::int16_t, std::uint32_t, std::int64_t,
+                   E) {
+    stdx::cx_set<TestType, 100> s{};
+    for (auto n = std::size_t{}; n < 100; ++n) {
+        CHECK(not s.contains(static_cast<TestType>(n + 1)));
+        s.insert(static_cast<TestType>(n + 1));
+        for (auto i = std::size_t{}; i <= n; ++i) {
+            REQUIRE(s.contains(static_cast<TestType>(i + 1)));
+        }
+        CHECK(not s.contains(TestType{}));
+    }
+}
+
+TEMPLATE_TEST_CASE("contains ignores keys past the end", "[cx_set]",
+                   std::uint8_t, std::int16_t, std::uint32_t, std::int64_t,
+                   E) {
+    stdx::cx_set<TestType, 64> s{};
+    for (auto i = 0; i < 64; ++i) {
+        s.insert(static_cast<TestType>(i));
+    }
+    for (auto i = 63; i >= 0; --i) {
+        CHECK(s.pop_back() == static_cast<TestType>(i));
+        CHECK(not s.contains(static_cast<TestType>(i)));
+        CHECK(s.erase(static_cast<TestType>(i)) == 0u);
+    }
+    CHECK(s.empty());
+}
+
+TEMPLATE_TEST_CASE("erase moves the last key", "[cx_set]", std::uint8_t,
+                   std::uint32_t, std::uint64_t) {
+    stdx::cx_set<TestType, 40> s{};
+    for (auto i = 0; i < 40; ++i) {
+        s.insert(static_cast<TestType>(i));
+    }
+    CHECK(s.erase(TestType{5}) == 1u);
+    CHECK(s.size() == 39);
+    CHECK(*(s.begin() + 5) == TestType{39});
+    CHECK(not s.contains(TestType{5}));
+    CHECK(s.contains(TestType{39}));
+}
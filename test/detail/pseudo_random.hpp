@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// xorshift64: a small generator for test fixtures that also works in constant
+// evaluation (the seed must not be zero)
+class pseudo_random {
+    std::uint64_t state;
+
+  public:
+    constexpr explicit pseudo_random(std::uint64_t seed) : state{seed} {}
+
+    constexpr auto operator()() -> std::uint64_t {
+        state ^= state << 13u;
+        state ^= state >> 7u;
+        state ^= state << 17u;
+        return state;
+    }
+};
+
+// a bitset in which each bit is set with probability density/16
+template <typename BS>
+constexpr auto pseudo_random_bitset(std::uint64_t seed, unsigned density = 8)
+    -> BS {
+    auto bs = BS{};
+    auto next = pseudo_random{seed};
+    for (auto i = std::size_t{}; i < bs.capacity(); ++i) {
+        bs.set(i, next() % 16u < density);
+    }
+    return bs;
+}
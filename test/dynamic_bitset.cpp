@@ -0,0 +1,289 @@
+#include <stdx/bitset.hpp>
+#include <stdx/dynamic_bitset.hpp>
+#include <stdx/span.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace {
+int panics{};
+
+struct injected_handler {
+    template <typename... Args> static auto panic(Args &&...) -> void {
+        ++panics;
+    }
+
+    template <stdx::ct_string Why, typename... Args>
+    static auto panic(Args &&...) -> void {
+        ++panics;
+    }
+};
+} // namespace
+template <> inline auto stdx::panic_handler<> = injected_handler{};
+
+TEMPLATE_TEST_CASE("dynamic_bitset capacity is set at runtime",
+                   "[dynamic_bitset]", std::uint8_t, std::uint16_t,
+                   std::uint32_t, std::uint64_t) {
+    auto n = std::size_t{17};
+    auto bs = stdx::dynamic_bitset<TestType>{n};
+    CHECK(bs.capacity() == 17);
+    CHECK(bs.none());
+}
+
+TEST_CASE("dynamic_bitset inline capacity", "[dynamic_bitset]") {
+    STATIC_REQUIRE(stdx::dynamic_bitset<std::uint64_t>::inline_capacity() ==
+                   128);
+    STATIC_REQUIRE(stdx::dynamic_bitset<std::uint8_t, 12>::inline_capacity() ==
+                   16);
+}
+
+TEMPLATE_TEST_CASE("dynamic_bitset set, reset and flip single bits",
+                   "[dynamic_bitset]", std::uint8_t, std::uint16_t,
+                   std::uint32_t, std::uint64_t) {
+    auto bs = stdx::dynamic_bitset<TestType>{300};
+    bs.set(0);
+    bs.set(299);
+    bs.set(150);
+    CHECK(bs[0]);
+    CHECK(bs[150]);
+    CHECK(bs[299]);
+    CHECK(bs.count() == 3);
+    bs.reset(150);
+    CHECK(not bs[150]);
+    bs.flip(150);
+    CHECK(bs[150]);
+    bs.set(150, false);
+    CHECK(not bs[150]);
+}
+
+TEMPLATE_TEST_CASE("dynamic_bitset construct with a value", "[dynamic_bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t) {
+    auto bs = stdx::dynamic_bitset<TestType>{40, 0b1010'0000'0001ul};
+    CHECK(bs[0]);
+    CHECK(bs[9]);
+    CHECK(bs[11]);
+    CHECK(bs.count() == 3);
+}
+
+TEST_CASE("dynamic_bitset construct with placed bits", "[dynamic_bitset]") {
+    auto bs = stdx::dynamic_bitset<>{200, stdx::place_bits, 1, 65, 199};
+    CHECK(bs[1]);
+    CHECK(bs[65]);
+    CHECK(bs[199]);
+    CHECK(bs.count() == 3);
+}
+
+TEMPLATE_TEST_CASE("dynamic_bitset construct with all bits",
+                   "[dynamic_bitset]", std::uint8_t, std::uint16_t,
+                   std::uint32_t, std::uint64_t) {
+    auto bs = stdx::dynamic_bitset<TestType>{301, stdx::all_bits};
+    CHECK(bs.all());
+    CHECK(bs.count() == 301);
+}
+
+TEST_CASE("dynamic_bitset construct with a string_view", "[dynamic_bitset]") {
+    using namespace std::string_view_literals;
+    auto bs = stdx::dynamic_bitset<>{"1100"sv};
+    CHECK(bs.capacity() == 4);
+    CHECK(bs == stdx::dynamic_bitset<>{4, 0b1100ul});
+
+    auto bs2 = stdx::dynamic_bitset<>{"AABB"sv, 0, 2, 'A'};
+    CHECK(bs2 == stdx::dynamic_bitset<>{2, 0b11ul});
+}
+
+TEMPLATE_TEST_CASE("dynamic_bitset set and reset ranges", "[dynamic_bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t) {
+    using namespace stdx::literals;
+    auto bs = stdx::dynamic_bitset<TestType>{200};
+    bs.set(10_lsb, 150_msb);
+    CHECK(bs.count() == 141);
+    CHECK(not bs[9]);
+    CHECK(bs[10]);
+    CHECK(bs[150]);
+    CHECK(not bs[151]);
+    bs.reset(20_lsb, 10_len);
+    CHECK(bs.count() == 131);
+    CHECK(bs[19]);
+    CHECK(not bs[20]);
+    CHECK(not bs[29]);
+    CHECK(bs[30]);
+}
+
+TEMPLATE_TEST_CASE("dynamic_bitset all, any, none", "[dynamic_bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t) {
+    auto bs = stdx::dynamic_bitset<TestType>{70};
+    CHECK(bs.none());
+    CHECK(not bs.any());
+    bs.set();
+    CHECK(bs.all());
+    CHECK(bs.count() == 70);
+    bs.reset();
+    CHECK(bs.empty());
+}
+
+TEST_CASE("dynamic_bitset copies and moves (inline)", "[dynamic_bitset]") {
+    auto bs = stdx::dynamic_bitset<>{100, stdx::place_bits, 3, 99};
+    auto copy = bs;
+    CHECK(copy == bs);
+    auto moved = std::move(copy);
+    CHECK(moved == bs);
+    copy = moved;
+    CHECK(copy == bs);
+}
+
+TEST_CASE("dynamic_bitset copies and moves (heap)", "[dynamic_bitset]") {
+    auto bs = stdx::dynamic_bitset<>{1000, stdx::place_bits, 3, 999};
+    auto copy = bs;
+    CHECK(copy == bs);
+    auto moved = std::move(copy);
+    CHECK(moved == bs);
+    copy = moved;
+    CHECK(copy == bs);
+    auto small = stdx::dynamic_bitset<>{10};
+    small = moved;
+    CHECK(small == bs);
+    moved = stdx::dynamic_bitset<>{10};
+    CHECK(moved.capacity() == 10);
+}
+
+TEMPLATE_TEST_CASE("dynamic_bitset resize", "[dynamic_bitset]", std::uint8_t,
+                   std::uint16_t, std::uint32_t, std::uint64_t) {
+    auto bs = stdx::dynamic_bitset<TestType>{10, stdx::all_bits};
+    bs.resize(1000);
+    CHECK(bs.capacity() == 1000);
+    CHECK(bs.count() == 10);
+    bs.set(999);
+    bs.resize(5);
+    CHECK(bs.count() == 5);
+    bs.resize(100);
+    CHECK(bs.count() == 5);
+    CHECK(not bs[99]);
+}
+
+TEMPLATE_TEST_CASE("dynamic_bitset bitwise operations", "[dynamic_bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t) {
+    auto const a = stdx::dynamic_bitset<TestType>{500, stdx::place_bits, 1, 2,
+                                                  300, 499};
+    auto const b = stdx::dynamic_bitset<TestType>{500, stdx::place_bits, 2, 3,
+                                                  300};
+    CHECK((a | b) == stdx::dynamic_bitset<TestType>{500, stdx::place_bits, 1,
+                                                    2, 3, 300, 499});
+    CHECK((a & b) ==
+          stdx::dynamic_bitset<TestType>{500, stdx::place_bits, 2, 300});
+    CHECK((a ^ b) ==
+          stdx::dynamic_bitset<TestType>{500, stdx::place_bits, 1, 3, 499});
+    CHECK((a - b) ==
+          stdx::dynamic_bitset<TestType>{500, stdx::place_bits, 1, 499});
+    CHECK((~a).count() == 496);
+    CHECK(a != b);
+}
+
+TEMPLATE_TEST_CASE("dynamic_bitset shifts", "[dynamic_bitset]", std::uint8_t,
+                   std::uint16_t, std::uint32_t, std::uint64_t) {
+    auto const a = stdx::dynamic_bitset<TestType>{300, stdx::place_bits, 0,
+                                                  100, 299};
+    CHECK((a << 1) ==
+          stdx::dynamic_bitset<TestType>{300, stdx::place_bits, 1, 101});
+    CHECK((a >> 100) ==
+          stdx::dynamic_bitset<TestType>{300, stdx::place_bits, 0, 199});
+    CHECK((~stdx::dynamic_bitset<TestType>{3} >> 1) ==
+          stdx::dynamic_bitset<TestType>{3, 0b11ul});
+}
+
+TEMPLATE_TEST_CASE("dynamic_bitset for_each", "[dynamic_bitset]", std::uint8_t,
+                   std::uint16_t, std::uint32_t, std::uint64_t) {
+    auto const bs = stdx::dynamic_bitset<TestType>{200, stdx::place_bits, 1,
+                                                   64, 199};
+    auto set_bits = std::vector<std::size_t>{};
+    for_each([&](auto i) { set_bits.push_back(i); }, bs);
+    CHECK(set_bits == std::vector<std::size_t>{1, 64, 199});
+
+    auto unset_count = std::size_t{};
+    for_each<stdx::unset_bit>([&](auto) { ++unset_count; }, bs);
+    CHECK(unset_count == 197);
+
+    auto all_count = std::size_t{};
+    auto true_count = std::size_t{};
+    for_each<stdx::bit>(
+        [&](auto, bool b) {
+            ++all_count;
+            true_count += b;
+        },
+        ~bs);
+    CHECK(all_count == 200);
+    CHECK(true_count == 197);
+}
+
+TEMPLATE_TEST_CASE("dynamic_bitset transform_reduce", "[dynamic_bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t) {
+    auto const bs = ~stdx::dynamic_bitset<TestType>{13};
+    CHECK(transform_reduce([](auto i) { return i; }, std::plus{},
+                           std::size_t{}, bs) == 78);
+}
+
+TEMPLATE_TEST_CASE("dynamic_bitset lowest_unset", "[dynamic_bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t) {
+    auto bs = stdx::dynamic_bitset<TestType>{100, stdx::all_bits};
+    CHECK(bs.lowest_unset() == 100);
+    bs.reset(70);
+    CHECK(bs.lowest_unset() == 70);
+}
+
+TEMPLATE_TEST_CASE("dynamic_bitset decode set bits", "[dynamic_bitset]",
+                   std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t) {
+    auto const bs = stdx::dynamic_bitset<TestType>{300, stdx::place_bits, 0,
+                                                   63, 64, 150, 299};
+    auto buffer = std::array<std::uint16_t, 3>{};
+    CHECK(bs.decode_set_bits(stdx::span{buffer}) == 3);
+    CHECK(buffer == std::array<std::uint16_t, 3>{0, 63, 64});
+    CHECK(bs.decode_set_bits(stdx::span{buffer}, 65) == 2);
+    CHECK(buffer[0] == 150);
+    CHECK(buffer[1] == 299);
+}
+
+TEST_CASE("dynamic_bitset matches bitset", "[dynamic_bitset]") {
+    constexpr auto sbs = stdx::bitset<777>{stdx::place_bits, 3, 64, 500, 776};
+    auto dbs = stdx::dynamic_bitset<>{777, stdx::place_bits, 3, 64, 500, 776};
+    CHECK(dbs.count() == sbs.count());
+    CHECK((~dbs).count() == (~sbs).count());
+    CHECK((dbs << 77).count() == (sbs << 77).count());
+    CHECK((dbs >> 77).count() == (sbs >> 77).count());
+    CHECK(dbs.lowest_unset() == sbs.lowest_unset());
+}
+
+TEST_CASE("dynamic_bitset is constexpr", "[dynamic_bitset]") {
+    constexpr auto count = [] {
+        auto bs = stdx::dynamic_bitset<std::uint8_t>{1000, stdx::all_bits};
+        bs.reset(3);
+        bs >>= 10;
+        return bs.count();
+    }();
+    STATIC_REQUIRE(count == 990);
+}
+
+TEST_CASE("dynamic_bitset binary operations require equal sizes",
+          "[dynamic_bitset]") {
+    panics = 0;
+    auto small = stdx::dynamic_bitset<std::uint8_t>{10};
+    small.set(1);
+    auto const big = stdx::dynamic_bitset<std::uint8_t>{300};
+    small |= big;
+    small &= big;
+    small ^= big;
+    CHECK(panics == 3);
+    CHECK(small.count() == 1);
+    CHECK(small[1]);
+
+    panics = 0;
+    CHECK((small | big) == small);
+    CHECK((big & small) == big);
+    CHECK((small ^ big) == small);
+    CHECK(panics == 3);
+}
@@ -0,0 +1,102 @@
+#include <stdx/enum_map.hpp>
+#include <stdx/iterator.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+enum struct color : std::uint8_t { red, green, blue, MAX };
+} // namespace
+
+TEST_CASE("enum_map capacity", "[enum_map]") {
+    STATIC_REQUIRE(stdx::enum_map<color, int>::capacity() == 3);
+    STATIC_REQUIRE(stdx::ct_capacity_v<stdx::enum_map<color, int>> == 3);
+}
+
+TEST_CASE("enum_map empty and size", "[enum_map]") {
+    auto m = stdx::enum_map<color, int>{};
+    CHECK(m.size() == 0);
+    CHECK(m.empty());
+    CHECK(m.insert_or_assign(color::green, 5));
+    CHECK(m.size() == 1);
+    CHECK(not m.empty());
+}
+
+TEST_CASE("enum_map contains and get", "[enum_map]") {
+    auto m = stdx::enum_map<color, int>{};
+    CHECK(m.put(color::red, 1));
+    CHECK(m.put(color::blue, 3));
+    REQUIRE(m.contains(color::red));
+    CHECK(m.get(color::red) == 1);
+    REQUIRE(m.contains(color::blue));
+    CHECK(m.get(color::blue) == 3);
+    CHECK(not m.contains(color::green));
+}
+
+TEST_CASE("enum_map insert_or_assign", "[enum_map]") {
+    auto m = stdx::enum_map<color, int>{};
+    CHECK(m.insert_or_assign(color::red, 1));
+    CHECK(not m.insert_or_assign(color::red, 2));
+    CHECK(m.get(color::red) == 2);
+    CHECK(m.size() == 1);
+}
+
+TEST_CASE("enum_map erase", "[enum_map]") {
+    auto m = stdx::enum_map<color, std::string>{};
+    m.put(color::red, "red");
+    CHECK(m.erase(color::red) == 1);
+    CHECK(m.erase(color::red) == 0);
+    CHECK(not m.contains(color::red));
+    CHECK(m.empty());
+}
+
+TEST_CASE("enum_map full and clear", "[enum_map]") {
+    auto m = stdx::enum_map<color, int>{};
+    m.put(color::red, 1);
+    m.put(color::green, 2);
+    m.put(color::blue, 3);
+    CHECK(m.full());
+    m.clear();
+    CHECK(m.empty());
+}
+
+TEST_CASE("enum_map for_each visits present keys in order", "[enum_map]") {
+    auto m = stdx::enum_map<color, int>{};
+    m.put(color::blue, 3);
+    m.put(color::red, 1);
+    auto seen = std::vector<std::pair<color, int>>{};
+    std::as_const(m).for_each(
+        [&](color c, int const &v) { seen.emplace_back(c, v); });
+    CHECK(seen == std::vector<std::pair<color, int>>{{color::red, 1},
+                                                     {color::blue, 3}});
+
+    m.for_each([](auto, int &v) { v *= 10; });
+    CHECK(m.get(color::red) == 10);
+    CHECK(m.get(color::blue) == 30);
+}
+
+TEST_CASE("enum_map is usable at compile time", "[enum_map]") {
+    constexpr auto m = [] {
+        auto r = stdx::enum_map<color, int>{};
+        r.put(color::green, 42);
+        return r;
+    }();
+    STATIC_REQUIRE(m.contains(color::green));
+    STATIC_REQUIRE(m.get(color::green) == 42);
+    STATIC_REQUIRE(m.keys() == stdx::enum_set{color::green});
+}
+
+TEST_CASE("enum_map equality", "[enum_map]") {
+    auto a = stdx::enum_map<color, int>{};
+    auto b = stdx::enum_map<color, int>{};
+    a.put(color::red, 1);
+    CHECK(a != b);
+    b.put(color::red, 1);
+    CHECK(a == b);
+    b.put(color::red, 2);
+    CHECK(a != b);
+}
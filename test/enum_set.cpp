@@ -0,0 +1,64 @@
+#include <stdx/enum_set.hpp>
+#include <stdx/iterator.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+enum struct color : std::uint8_t { red, green, blue, MAX };
+enum struct level { low, mid, high };
+} // namespace
+
+TEST_CASE("enum_set capacity", "[enum_set]") {
+    STATIC_REQUIRE(stdx::enum_set<color>::capacity() == 3);
+    STATIC_REQUIRE(stdx::enum_set<level, level::high>::capacity() == 2);
+    STATIC_REQUIRE(stdx::ct_capacity_v<stdx::enum_set<color>> == 3);
+}
+
+TEST_CASE("enum_set empty and size", "[enum_set]") {
+    auto s = stdx::enum_set<color>{};
+    CHECK(s.empty());
+    CHECK(s.size() == 0);
+    CHECK(s.insert(color::green));
+    CHECK(not s.empty());
+    CHECK(s.size() == 1);
+}
+
+TEST_CASE("enum_set insert, contains and erase", "[enum_set]") {
+    auto s = stdx::enum_set<color>{};
+    CHECK(s.insert(color::red));
+    CHECK(not s.insert(color::red));
+    CHECK(s.contains(color::red));
+    CHECK(not s.contains(color::blue));
+    CHECK(s.erase(color::red) == 1);
+    CHECK(s.erase(color::red) == 0);
+    CHECK(not s.contains(color::red));
+}
+
+TEST_CASE("enum_set construction", "[enum_set]") {
+    constexpr auto s = stdx::enum_set{color::red, color::blue};
+    STATIC_REQUIRE(s.size() == 2);
+    STATIC_REQUIRE(s.contains(color::red));
+    STATIC_REQUIRE(not s.contains(color::green));
+}
+
+TEST_CASE("enum_set full and clear", "[enum_set]") {
+    auto s = stdx::enum_set{color::red, color::green, color::blue};
+    CHECK(s.full());
+    s.clear();
+    CHECK(s.empty());
+}
+
+TEST_CASE("enum_set for_each visits present keys in order", "[enum_set]") {
+    auto const s = stdx::enum_set{color::blue, color::red};
+    auto keys = std::vector<color>{};
+    s.for_each([&](color c) { keys.push_back(c); });
+    CHECK(keys == std::vector{color::red, color::blue});
+}
+
+TEST_CASE("enum_set equality", "[enum_set]") {
+    STATIC_REQUIRE(stdx::enum_set{color::red} == stdx::enum_set{color::red});
+    STATIC_REQUIRE(stdx::enum_set{color::red} != stdx::enum_set{color::blue});
+}
@@ -0,0 +1,8 @@
+#include <stdx/frozen_map.hpp>
+
+// EXPECT: keys_must_be_distinct
+
+auto main() -> int {
+    [[maybe_unused]] constexpr auto m =
+        stdx::make_frozen_map<int, int>({{1, 10}, {2, 20}, {1, 30}});
+}
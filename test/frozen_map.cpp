@@ -0,0 +1,104 @@
+#include <stdx/ct_string.hpp>
+#include <stdx/frozen_map.hpp>
+#include <stdx/iterator.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace {
+enum struct colour : std::uint8_t { red, green, blue };
+
+template <std::size_t N> constexpr auto squares() {
+    std::array<stdx::cx_map_value<std::uint32_t, std::uint32_t>, N> a{};
+    for (auto i = std::uint32_t{}; i < N; ++i) {
+        a[i] = {i * 7919u, i * i};
+    }
+    return a;
+}
+} // namespace
+
+TEST_CASE("make_frozen_map", "[frozen_map]") {
+    constexpr auto m =
+        stdx::make_frozen_map<int, int>({{1, 10}, {2, 20}, {3, 30}});
+    STATIC_REQUIRE(std::is_same_v<decltype(m),
+                                  stdx::frozen_map<int, int, 3> const>);
+    STATIC_REQUIRE(m.size() == 3);
+    STATIC_REQUIRE(not m.empty());
+    STATIC_REQUIRE(stdx::ct_capacity_v<decltype(m)> == 3);
+}
+
+TEST_CASE("contains and get", "[frozen_map]") {
+    constexpr auto m =
+        stdx::make_frozen_map<int, int>({{1, 10}, {2, 20}, {3, 30}});
+    STATIC_REQUIRE(m.contains(1));
+    STATIC_REQUIRE(m.get(2) == 20);
+    STATIC_REQUIRE(not m.contains(4));
+
+    auto const k = 3;
+    REQUIRE(m.contains(k));
+    CHECK(m.get(k) == 30);
+    CHECK(not m.contains(k + 1));
+}
+
+TEST_CASE("find", "[frozen_map]") {
+    constexpr auto m = stdx::make_frozen_map<int, int>({{1, 10}, {2, 20}});
+    STATIC_REQUIRE(m.find(1)->value == 10);
+    STATIC_REQUIRE(m.find(3) == m.end());
+}
+
+TEST_CASE("iteration visits every entry", "[frozen_map]") {
+    constexpr auto m =
+        stdx::make_frozen_map<int, int>({{1, 10}, {2, 20}, {3, 30}});
+    auto sum = 0;
+    for (auto const &[k, v] : m) {
+        sum += k + v;
+    }
+    CHECK(sum == 66);
+}
+
+TEST_CASE("empty map", "[frozen_map]") {
+    constexpr auto m = stdx::frozen_map<int, int, 0>{{}};
+    STATIC_REQUIRE(m.empty());
+    STATIC_REQUIRE(not m.contains(0));
+}
+
+TEST_CASE("enum keys", "[frozen_map]") {
+    using namespace std::string_view_literals;
+    constexpr auto m = stdx::make_frozen_map<colour, std::string_view>(
+        {{colour::red, "red"sv}, {colour::blue, "blue"sv}});
+    STATIC_REQUIRE(m.get(colour::blue) == "blue"sv);
+    STATIC_REQUIRE(not m.contains(colour::green));
+}
+
+TEST_CASE("string keys", "[frozen_map]") {
+    using namespace std::string_view_literals;
+    constexpr auto m = stdx::make_frozen_map<std::string_view, int>(
+        {{"one"sv, 1}, {"two"sv, 2}, {"three"sv, 3}});
+    STATIC_REQUIRE(m.get("three"sv) == 3);
+    STATIC_REQUIRE(not m.contains("four"sv));
+    constexpr auto key = stdx::ct_string{"two"};
+    STATIC_REQUIRE(m.get(std::string_view{key}) == 2);
+}
+
+TEST_CASE("CTAD from std::array", "[frozen_map]") {
+    constexpr auto m = stdx::frozen_map{squares<5>()};
+    using expected_t = stdx::frozen_map<std::uint32_t, std::uint32_t, 5>;
+    STATIC_REQUIRE(std::is_same_v<decltype(m), expected_t const>);
+    STATIC_REQUIRE(m.get(4 * 7919u) == 16);
+}
+
+TEST_CASE("larger map", "[frozen_map]") {
+    constexpr static auto entries = squares<200>();
+    constexpr static auto m = stdx::frozen_map{entries};
+    STATIC_REQUIRE(m.get(199 * 7919u) == 199 * 199);
+    for (auto const &[k, v] : entries) {
+        REQUIRE(m.contains(k));
+        CHECK(m.get(k) == v);
+        CHECK(not m.contains(k + 1));
+    }
+}
@@ -0,0 +1,49 @@
+#include <stdx/frozen_set.hpp>
+#include <stdx/iterator.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+TEST_CASE("make_frozen_set", "[frozen_set]") {
+    constexpr auto s = stdx::make_frozen_set({3, 1, 4, 5, 9, 2, 6});
+    STATIC_REQUIRE(
+        std::is_same_v<decltype(s), stdx::frozen_set<int, 7> const>);
+    STATIC_REQUIRE(s.size() == 7);
+    STATIC_REQUIRE(stdx::ct_capacity_v<decltype(s)> == 7);
+}
+
+TEST_CASE("contains", "[frozen_set]") {
+    constexpr auto s = stdx::make_frozen_set({3, 1, 4, 5, 9, 2, 6});
+    STATIC_REQUIRE(s.contains(9));
+    STATIC_REQUIRE(not s.contains(7));
+    for (auto i = 0; i < 10; ++i) {
+        CHECK(s.contains(i) == (i != 0 and i != 7 and i != 8));
+    }
+}
+
+TEST_CASE("iteration visits every key", "[frozen_set]") {
+    constexpr auto s = stdx::make_frozen_set({3, 1, 4});
+    auto sum = 0;
+    for (auto k : s) {
+        sum += k;
+    }
+    CHECK(sum == 8);
+}
+
+TEST_CASE("string keys", "[frozen_set]") {
+    using namespace std::string_view_literals;
+    constexpr auto s = stdx::make_frozen_set({"GET"sv, "PUT"sv, "POST"sv});
+    STATIC_REQUIRE(s.contains("POST"sv));
+    STATIC_REQUIRE(not s.contains("PATCH"sv));
+}
+
+TEST_CASE("CTAD from std::array", "[frozen_set]") {
+    constexpr auto s = stdx::frozen_set{std::array{1u, 2u, 3u}};
+    STATIC_REQUIRE(
+        std::is_same_v<decltype(s), stdx::frozen_set<unsigned, 3> const>);
+    STATIC_REQUIRE(s.contains(2u));
+}
@@ -0,0 +1,35 @@
+#include <stdx/ct_string.hpp>
+#include <stdx/hash.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string_view>
+
+namespace {
+enum struct E : std::uint8_t { A = 1 };
+} // namespace
+
+TEST_CASE("integral keys", "[hash]") {
+    constexpr auto h = stdx::cx_hash{};
+    STATIC_REQUIRE(h(1) == h(1u));
+    STATIC_REQUIRE(h(1) != h(2));
+}
+
+TEST_CASE("enum keys hash as their underlying value", "[hash]") {
+    constexpr auto h = stdx::cx_hash{};
+    STATIC_REQUIRE(h(E::A) == h(1));
+}
+
+TEST_CASE("string keys", "[hash]") {
+    using namespace std::string_view_literals;
+    constexpr auto h = stdx::cx_hash{};
+    STATIC_REQUIRE(h("abc"sv) == h("abc"sv));
+    STATIC_REQUIRE(h("abc"sv) != h("abd"sv));
+    STATIC_REQUIRE(h(stdx::ct_string{"abc"}) == h("abc"sv));
+}
+
+TEST_CASE("mix spreads low bits", "[hash]") {
+    STATIC_REQUIRE(stdx::cx_hash::mix(1) >> 32u != 0);
+    STATIC_REQUIRE(stdx::cx_hash::mix(2) >> 32u != 0);
+}
@@ -0,0 +1,194 @@
+#include "detail/pseudo_random.hpp"
+
+#include <stdx/bitset.hpp>
+#include <stdx/hierarchical_bitset.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+TEST_CASE("hierarchical_bitset capacity", "[hierarchical_bitset]") {
+    STATIC_REQUIRE(stdx::hierarchical_bitset<1>::capacity() == 1);
+    STATIC_REQUIRE(stdx::hierarchical_bitset<65536>::capacity() == 65536);
+}
+
+TEST_CASE("hierarchical_bitset default construction",
+          "[hierarchical_bitset]") {
+    constexpr auto bs = stdx::hierarchical_bitset<1000>{};
+    STATIC_REQUIRE(bs.none());
+    STATIC_REQUIRE(bs.lowest_set() == 1000);
+    STATIC_REQUIRE(bs.lowest_unset() == 0);
+}
+
+TEST_CASE("hierarchical_bitset construct with placed bits",
+          "[hierarchical_bitset]") {
+    constexpr auto bs =
+        stdx::hierarchical_bitset<5000>{stdx::place_bits, 4097, 4999};
+    STATIC_REQUIRE(bs[4097]);
+    STATIC_REQUIRE(bs[4999]);
+    STATIC_REQUIRE(bs.count() == 2);
+    STATIC_REQUIRE(bs.lowest_set() == 4097);
+}
+
+TEST_CASE("hierarchical_bitset construct with a value",
+          "[hierarchical_bitset]") {
+    constexpr auto bs = stdx::hierarchical_bitset<200>{0b1010ul};
+    STATIC_REQUIRE(bs.count() == 2);
+    STATIC_REQUIRE(bs.lowest_set() == 1);
+}
+
+TEST_CASE("hierarchical_bitset construct with all bits",
+          "[hierarchical_bitset]") {
+    constexpr auto bs = stdx::hierarchical_bitset<4100>{stdx::all_bits};
+    STATIC_REQUIRE(bs.all());
+    STATIC_REQUIRE(bs.count() == 4100);
+    STATIC_REQUIRE(bs.lowest_unset() == 4100);
+}
+
+TEST_CASE("hierarchical_bitset construct from bitset",
+          "[hierarchical_bitset]") {
+    constexpr auto b = stdx::bitset<300>{stdx::place_bits, 3, 64, 299};
+    constexpr auto bs = stdx::hierarchical_bitset<300>{b};
+    STATIC_REQUIRE(bs.count() == 3);
+    STATIC_REQUIRE(bs.to_bitset() == b);
+}
+
+TEST_CASE("hierarchical_bitset lowest_set descends the summaries",
+          "[hierarchical_bitset]") {
+    auto bs = stdx::hierarchical_bitset<1'000'000>{};
+    CHECK(bs.lowest_set() == 1'000'000);
+    bs.set(999'999);
+    CHECK(bs.lowest_set() == 999'999);
+    bs.set(262'145);
+    CHECK(bs.lowest_set() == 262'145);
+    bs.reset(262'145);
+    CHECK(bs.lowest_set() == 999'999);
+    bs.reset(999'999);
+    CHECK(bs.lowest_set() == 1'000'000);
+    CHECK(bs.none());
+}
+
+TEST_CASE("hierarchical_bitset lowest_unset descends the summaries",
+          "[hierarchical_bitset]") {
+    auto bs = stdx::hierarchical_bitset<1'000'000>{stdx::all_bits};
+    CHECK(bs.lowest_unset() == 1'000'000);
+    bs.reset(777'777);
+    CHECK(bs.lowest_unset() == 777'777);
+    bs.flip(4096);
+    CHECK(bs.lowest_unset() == 4096);
+    bs.flip(4096);
+    CHECK(bs.lowest_unset() == 777'777);
+    bs.set(777'777);
+    CHECK(bs.all());
+}
+
+TEST_CASE("hierarchical_bitset lowest_unset ignores bits beyond the size",
+          "[hierarchical_bitset]") {
+    auto bs = stdx::hierarchical_bitset<65>{stdx::all_bits};
+    CHECK(bs.all());
+    bs.reset(64);
+    CHECK(bs.lowest_unset() == 64);
+}
+
+TEST_CASE("hierarchical_bitset set and reset ranges", "[hierarchical_bitset]") {
+    using namespace stdx::literals;
+    auto bs = stdx::hierarchical_bitset<10'000>{};
+    bs.set(100_lsb, 8999_msb);
+    CHECK(bs.count() == 8900);
+    CHECK(bs.lowest_set() == 100);
+    bs.reset(0_lsb, 5000_len);
+    CHECK(bs.lowest_set() == 5000);
+    bs.set(0_lsb, 9999_msb);
+    CHECK(bs.all());
+    bs.reset(9000_lsb, 9999_msb);
+    CHECK(bs.lowest_unset() == 9000);
+}
+
+TEST_CASE("hierarchical_bitset set, reset and flip all",
+          "[hierarchical_bitset]") {
+    auto bs = stdx::hierarchical_bitset<5000>{stdx::place_bits, 42};
+    bs.flip();
+    CHECK(bs.count() == 4999);
+    CHECK(bs.lowest_unset() == 42);
+    bs.set();
+    CHECK(bs.all());
+    bs.reset();
+    CHECK(bs.none());
+}
+
+TEST_CASE("hierarchical_bitset for_each visits set bits in order",
+          "[hierarchical_bitset]") {
+    auto const bs = stdx::hierarchical_bitset<300'000>{
+        stdx::place_bits, 0, 63, 64, 4095, 4096, 262'144, 299'999};
+    auto v = std::vector<std::size_t>{};
+    for_each([&](auto i) { v.push_back(i); }, bs);
+    CHECK(v == std::vector<std::size_t>{0, 63, 64, 4095, 4096, 262'144,
+                                        299'999});
+}
+
+TEST_CASE("hierarchical_bitset for_each visits unset bits in order",
+          "[hierarchical_bitset]") {
+    auto bs = stdx::hierarchical_bitset<300'000>{stdx::all_bits};
+    bs.reset(5).reset(4096).reset(299'999);
+    auto v = std::vector<std::size_t>{};
+    for_each<stdx::unset_bit>([&](auto i) { v.push_back(i); }, bs);
+    CHECK(v == std::vector<std::size_t>{5, 4096, 299'999});
+}
+
+TEST_CASE("hierarchical_bitset transform_reduce", "[hierarchical_bitset]") {
+    constexpr auto bs = stdx::hierarchical_bitset<5000>{stdx::place_bits, 1,
+                                                        100, 4000};
+    STATIC_REQUIRE(transform_reduce([](auto i) { return i; }, std::plus{},
+                                    std::size_t{}, bs) == 4101);
+}
+
+TEST_CASE("hierarchical_bitset equality", "[hierarchical_bitset]") {
+    auto a = stdx::hierarchical_bitset<500>{stdx::place_bits, 1, 499};
+    auto b = stdx::hierarchical_bitset<500>{stdx::place_bits, 1};
+    CHECK(a != b);
+    b.set(499);
+    CHECK(a == b);
+}
+
+namespace {
+enum struct Bits : std::uint8_t { ZERO, ONE, TWO, THREE, MAX };
+}
+
+TEST_CASE("use hierarchical_bitset with enum struct",
+          "[hierarchical_bitset]") {
+    constexpr auto bs =
+        stdx::hierarchical_bitset<Bits::MAX>{stdx::place_bits, Bits::TWO};
+    STATIC_REQUIRE(bs[Bits::TWO]);
+    STATIC_REQUIRE(bs.lowest_set() == Bits::TWO);
+    STATIC_REQUIRE(bs.lowest_unset() == Bits::ZERO);
+}
+
+TEST_CASE("hierarchical_bitset matches bitset", "[hierarchical_bitset]") {
+    auto b = stdx::bitset<20'000, std::uint64_t>{};
+    auto h = stdx::hierarchical_bitset<20'000>{};
+    auto next = pseudo_random{2463534242u};
+    for (auto n = 0; n < 5000; ++n) {
+        auto const x = next();
+        auto const i = x % 20'000u;
+        if ((x >> 20u) % 3u == 0) {
+            b.reset(i);
+            h.reset(i);
+        } else {
+            b.set(i);
+            h.set(i);
+        }
+    }
+    CHECK(h.count() == b.count());
+    CHECK(h.lowest_unset() == b.lowest_unset());
+    CHECK(h.to_bitset() == b);
+}
+
+TEST_CASE("zero-size hierarchical_bitset", "[hierarchical_bitset]") {
+    constexpr auto bs = stdx::hierarchical_bitset<0>{};
+    STATIC_REQUIRE(bs.none());
+    STATIC_REQUIRE(bs.all());
+    STATIC_REQUIRE(bs.count() == 0);
+}
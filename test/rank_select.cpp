@@ -0,0 +1,104 @@
+#include "detail/pseudo_random.hpp"
+
+#include <stdx/bitset.hpp>
+#include <stdx/rank_select.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("rank_select of an empty bitset", "[rank_select]") {
+    constexpr auto rs = stdx::rank_select{stdx::bitset<100>{}};
+    STATIC_REQUIRE(rs.count() == 0);
+    STATIC_REQUIRE(rs.rank(50) == 0);
+    STATIC_REQUIRE(rs.rank<stdx::unset_bit>(50) == 50);
+    STATIC_REQUIRE(rs.select(0) == 100);
+}
+
+TEST_CASE("rank_select rank", "[rank_select]") {
+    constexpr auto rs =
+        stdx::rank_select{stdx::bitset<5000>{stdx::place_bits, 0, 64, 600,
+                                             2048, 4999}};
+    STATIC_REQUIRE(rs.count() == 5);
+    STATIC_REQUIRE(rs.rank(0) == 0);
+    STATIC_REQUIRE(rs.rank(1) == 1);
+    STATIC_REQUIRE(rs.rank(64) == 1);
+    STATIC_REQUIRE(rs.rank(65) == 2);
+    STATIC_REQUIRE(rs.rank(601) == 3);
+    STATIC_REQUIRE(rs.rank(2048) == 3);
+    STATIC_REQUIRE(rs.rank(2049) == 4);
+    STATIC_REQUIRE(rs.rank(4999) == 4);
+    STATIC_REQUIRE(rs.rank(5000) == 5);
+    STATIC_REQUIRE(rs.rank(10'000) == 5);
+    STATIC_REQUIRE(rs.rank<stdx::unset_bit>(601) == 598);
+}
+
+TEST_CASE("rank_select select", "[rank_select]") {
+    constexpr auto rs =
+        stdx::rank_select{stdx::bitset<5000>{stdx::place_bits, 0, 64, 600,
+                                             2048, 4999}};
+    STATIC_REQUIRE(rs.select(0) == 0);
+    STATIC_REQUIRE(rs.select(1) == 64);
+    STATIC_REQUIRE(rs.select(2) == 600);
+    STATIC_REQUIRE(rs.select(3) == 2048);
+    STATIC_REQUIRE(rs.select(4) == 4999);
+    STATIC_REQUIRE(rs.select(5) == 5000);
+}
+
+TEST_CASE("rank_select keeps the bits", "[rank_select]") {
+    constexpr auto rs =
+        stdx::rank_select{stdx::bitset<200>{stdx::place_bits, 3, 199}};
+    STATIC_REQUIRE(rs[3]);
+    STATIC_REQUIRE(rs[199]);
+    STATIC_REQUIRE(not rs[4]);
+    STATIC_REQUIRE(rs.capacity() == 200);
+}
+
+TEST_CASE("rank_select index is small", "[rank_select]") {
+    using bs_t = stdx::bitset<1 << 20, std::uint64_t>;
+    using rs_t = stdx::rank_select<1 << 20>;
+    STATIC_REQUIRE(sizeof(rs_t) - sizeof(bs_t) < sizeof(bs_t) / 20);
+}
+
+TEMPLATE_TEST_CASE("rank_select matches a naive count", "[rank_select]",
+                   std::uint8_t, std::uint16_t, std::uint32_t,
+                   std::uint64_t) {
+    using bs_t = stdx::bitset<50'000, TestType>;
+    for (auto density : {1u, 8u, 15u}) {
+        auto const bs = pseudo_random_bitset<bs_t>(0x1234'5678'9abc'def0u,
+                                                   density);
+        auto const rs = stdx::rank_select{bs};
+        REQUIRE(rs.count() == bs.count());
+
+        auto positions = std::vector<std::size_t>{};
+        for_each([&](auto i) { positions.push_back(i); }, bs);
+
+        auto r = std::size_t{};
+        auto mismatches = 0;
+        for (auto i = std::size_t{}; i <= bs.capacity(); ++i) {
+            mismatches += rs.rank(i) != r;
+            r += i < bs.capacity() and bs[i];
+        }
+        CHECK(mismatches == 0);
+
+        mismatches = 0;
+        for (auto k = std::size_t{}; k < positions.size(); ++k) {
+            mismatches += rs.select(k) != positions[k];
+            mismatches += rs.rank(positions[k]) != k;
+        }
+        CHECK(mismatches == 0);
+        CHECK(rs.select(positions.size()) == bs.capacity());
+    }
+}
+
+TEST_CASE("rank_select across sample boundaries", "[rank_select]") {
+    constexpr auto rs =
+        stdx::rank_select{stdx::bitset<100'000>{stdx::all_bits}};
+    STATIC_REQUIRE(rs.select(8191) == 8191);
+    STATIC_REQUIRE(rs.select(8192) == 8192);
+    STATIC_REQUIRE(rs.select(99'999) == 99'999);
+    STATIC_REQUIRE(rs.rank(77'777) == 77'777);
+}
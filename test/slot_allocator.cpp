@@ -0,0 +1,87 @@
+#include <stdx/slot_allocator.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+TEST_CASE("slot_allocator hands out each slot once", "[slot_allocator]") {
+    auto a = stdx::slot_allocator<70>{};
+    auto seen = std::array<bool, 70>{};
+    for (auto i = 0; i < 70; ++i) {
+        auto const s = a.acquire(0);
+        REQUIRE(s < 70);
+        CHECK(not seen[s]);
+        seen[s] = true;
+    }
+    CHECK(a.acquire(0) == a.capacity());
+    CHECK(a.count() == 70);
+}
+
+TEST_CASE("slot_allocator acquires the lowest free slot from the hint word",
+          "[slot_allocator]") {
+    auto a = stdx::slot_allocator<200>{};
+    CHECK(a.acquire(0) == 0);
+    CHECK(a.acquire(0) == 1);
+    CHECK(a.acquire(2) == 128);
+    CHECK(a.acquire(5) == 64);
+}
+
+TEST_CASE("slot_allocator release makes a slot available", "[slot_allocator]") {
+    auto a = stdx::slot_allocator<3>{};
+    CHECK(a.acquire() == 0);
+    CHECK(a.acquire() == 1);
+    CHECK(a.acquire() == 2);
+    CHECK(a.acquire() == 3);
+    a.release(1);
+    CHECK(not a.in_use(1));
+    CHECK(a.acquire() == 1);
+    CHECK(a.in_use(1));
+}
+
+TEST_CASE("slot_allocator under contention", "[slot_allocator]") {
+    constexpr auto slots = std::size_t{1000};
+    constexpr auto threads = 4;
+    constexpr auto rounds = 2000;
+    auto a = stdx::slot_allocator<slots>{};
+    auto owners = std::array<std::atomic<int>, slots>{};
+    auto errors = std::atomic<int>{};
+
+    auto work = [&] {
+        auto held = std::vector<std::size_t>{};
+        for (auto r = 0; r < rounds; ++r) {
+            auto const s = a.acquire();
+            if (s == slots) {
+                continue;
+            }
+            if (owners[s].fetch_add(1) != 0) {
+                ++errors;
+            }
+            held.push_back(s);
+            if (held.size() > 100) {
+                for (auto h : held) {
+                    owners[h].fetch_sub(1);
+                    a.release(h);
+                }
+                held.clear();
+            }
+        }
+        for (auto h : held) {
+            owners[h].fetch_sub(1);
+            a.release(h);
+        }
+    };
+
+    auto ts = std::vector<std::thread>{};
+    for (auto t = 0; t < threads; ++t) {
+        ts.emplace_back(work);
+    }
+    for (auto &t : ts) {
+        t.join();
+    }
+    CHECK(errors == 0);
+    CHECK(a.count() == 0);
+}
@@ -0,0 +1,143 @@
+#include <stdx/cx_map.hpp>
+#include <stdx/iterator.hpp>
+#include <stdx/soa_cx_map.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+
+namespace {
+using V = stdx::cx_map_value<int, int>;
+
+enum struct E : std::uint8_t { A, B, C };
+
+struct big {
+    std::array<std::uint32_t, 16> data{};
+    friend constexpr auto operator==(big const &, big const &)
+        -> bool = default;
+};
+} // namespace
+
+TEST_CASE("empty and size", "[soa_cx_map]") {
+    auto m = stdx::soa_cx_map<int, int, 8>{};
+    CHECK(m.empty());
+    CHECK(m.insert_or_assign(10, 50));
+    CHECK(m.size() == 1);
+    CHECK(not m.full());
+    STATIC_REQUIRE(stdx::ct_capacity_v<decltype(m)> == 8);
+}
+
+TEST_CASE("contains, get and update", "[soa_cx_map]") {
+    auto m = stdx::soa_cx_map<int, int, 8>{};
+    CHECK(m.put(10, 50));
+    CHECK(m.put(11, 100));
+    CHECK(not m.put(10, 60));
+    CHECK(m.size() == 2);
+    CHECK(m.get(10) == 60);
+    CHECK(m.contains(11));
+    CHECK(not m.contains(12));
+    m.get(11) = 5;
+    CHECK(m.get(11) == 5);
+}
+
+TEST_CASE("construct with entries", "[soa_cx_map]") {
+    constexpr auto m = stdx::soa_cx_map<int, int, 8>{V{1, 10}, V{2, 20}};
+    STATIC_REQUIRE(m.size() == 2);
+    STATIC_REQUIRE(m.get(2) == 20);
+    STATIC_REQUIRE(not m.contains(3));
+}
+
+TEST_CASE("erase moves the last entry", "[soa_cx_map]") {
+    auto m = stdx::soa_cx_map<int, int, 8>{V{1, 1}, V{2, 2}, V{3, 3}};
+    CHECK(m.erase(1) == 1u);
+    CHECK(m.erase(1) == 0u);
+    CHECK(m.size() == 2);
+    CHECK(m.keys()[0] == 3);
+    CHECK(m.values()[0] == 3);
+    CHECK(m.get(2) == 2);
+}
+
+TEST_CASE("pop_back", "[soa_cx_map]") {
+    auto m = stdx::soa_cx_map<int, int, 8>{V{1, 10}, V{2, 20}};
+    auto const e = m.pop_back();
+    CHECK(e.key == 2);
+    CHECK(e.value == 20);
+    CHECK(m.size() == 1);
+}
+
+TEST_CASE("clear", "[soa_cx_map]") {
+    auto m = stdx::soa_cx_map<int, int, 8>{V{1, 10}, V{2, 20}};
+    m.clear();
+    CHECK(m.empty());
+    CHECK(not m.contains(1));
+}
+
+TEST_CASE("iteration pairs keys with values", "[soa_cx_map]") {
+    auto m = stdx::soa_cx_map<int, int, 8>{V{1, 10}, V{2, 20}, V{3, 30}};
+    auto sum = 0;
+    for (auto [k, v] : m) {
+        CHECK(v == k * 10);
+        ++v;
+        sum += k;
+    }
+    CHECK(sum == 6);
+    CHECK(m.get(1) == 11);
+    CHECK(std::distance(std::cbegin(m), std::cend(m)) == 3);
+}
+
+TEST_CASE("keys and values are separate arrays", "[soa_cx_map]") {
+    auto m = stdx::soa_cx_map<int, int, 8>{V{1, 10}, V{2, 20}};
+    CHECK(m.keys().size() == 2);
+    CHECK(m.values().data() != nullptr);
+    m.values()[1] = 5;
+    CHECK(m.get(2) == 5);
+}
+
+TEST_CASE("enum keys", "[soa_cx_map]") {
+    auto m = stdx::soa_cx_map<E, int, 4>{};
+    m.put(E::C, 3);
+    m.put(E::A, 1);
+    CHECK(m.get(E::C) == 3);
+    CHECK(not m.contains(E::B));
+}
+
+TEST_CASE("small keys with large values", "[soa_cx_map]") {
+    auto m = stdx::soa_cx_map<std::uint32_t, big, 256>{};
+    for (auto i = std::uint32_t{}; i < 256; ++i) {
+        m.put(i * 3, big{{i}});
+    }
+    CHECK(m.full());
+    CHECK(m.get(255 * 3).data[0] == 255);
+    CHECK(not m.contains(1));
+}
+
+TEST_CASE("agrees with cx_map", "[soa_cx_map]") {
+    constexpr auto N = std::size_t{300};
+    auto soa = stdx::soa_cx_map<std::uint16_t, int, N>{};
+    auto ref = stdx::cx_map<std::uint16_t, int, N>{};
+    auto rng = std::mt19937{7};
+    auto key = std::uniform_int_distribution<std::uint16_t>{0, 400};
+    for (auto i = 0; i < 20'000; ++i) {
+        auto const k = key(rng);
+        switch (rng() % 3) {
+        case 0:
+            if (not ref.full() or ref.contains(k)) {
+                CHECK(soa.put(k, i) == ref.put(k, i));
+            }
+            break;
+        case 1:
+            CHECK(soa.erase(k) == ref.erase(k));
+            break;
+        default:
+            REQUIRE(soa.contains(k) == ref.contains(k));
+            if (ref.contains(k)) {
+                CHECK(soa.get(k) == ref.get(k));
+            }
+        }
+        REQUIRE(soa.size() == ref.size());
+    }
+}
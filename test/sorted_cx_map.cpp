@@ -0,0 +1,143 @@
+#include <stdx/iterator.hpp>
+#include <stdx/sorted_cx_map.hpp>
+#include <stdx/span.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+
+namespace {
+using V = stdx::cx_map_value<int, int>;
+
+template <typename M> constexpr auto keys_of(M const &m) {
+    std::array<int, M::capacity()> r{};
+    std::transform(m.begin(), m.end(), r.begin(),
+                   [](auto const &v) { return v.key; });
+    return r;
+}
+} // namespace
+
+TEST_CASE("empty and size", "[sorted_cx_map]") {
+    auto m = stdx::sorted_cx_map<int, int, 8>{};
+    CHECK(m.empty());
+    CHECK(m.insert_or_assign(10, 50));
+    CHECK(m.size() == 1);
+    STATIC_REQUIRE(stdx::ct_capacity_v<decltype(m)> == 8);
+}
+
+TEST_CASE("entries are kept in key order", "[sorted_cx_map]") {
+    constexpr auto m = [] {
+        auto t = stdx::sorted_cx_map<int, int, 5>{};
+        t.put(3, 30);
+        t.put(1, 10);
+        t.put(5, 50);
+        t.put(2, 20);
+        t.put(4, 40);
+        return t;
+    }();
+    STATIC_REQUIRE(keys_of(m) == std::array{1, 2, 3, 4, 5});
+    STATIC_REQUIRE(m.get(4) == 40);
+}
+
+TEST_CASE("contains, get and update", "[sorted_cx_map]") {
+    auto m = stdx::sorted_cx_map<int, int, 8>{};
+    CHECK(m.put(10, 50));
+    CHECK(m.put(11, 100));
+    CHECK(not m.put(10, 60));
+    CHECK(m.size() == 2);
+    CHECK(m.get(10) == 60);
+    CHECK(m.contains(11));
+    CHECK(not m.contains(12));
+    CHECK(not m.contains(9));
+    m.get(11) = 5;
+    CHECK(m.get(11) == 5);
+}
+
+TEST_CASE("erase", "[sorted_cx_map]") {
+    auto m = stdx::sorted_cx_map<int, int, 8>{V{1, 1}, V{2, 2}, V{3, 3}};
+    CHECK(m.erase(2) == 1u);
+    CHECK(m.erase(2) == 0u);
+    CHECK(m.size() == 2);
+    CHECK(m.get(1) == 1);
+    CHECK(m.get(3) == 3);
+}
+
+TEST_CASE("pop_back removes the greatest key", "[sorted_cx_map]") {
+    auto m = stdx::sorted_cx_map<int, int, 8>{V{2, 20}, V{9, 90}, V{4, 40}};
+    auto const e = m.pop_back();
+    CHECK(e.key == 9);
+    CHECK(e.value == 90);
+    CHECK(m.size() == 2);
+}
+
+TEST_CASE("construction sorts and keeps the last duplicate",
+          "[sorted_cx_map]") {
+    constexpr static auto m =
+        stdx::sorted_cx_map<int, int, 8>{V{3, 1}, V{1, 2}, V{3, 3}};
+    STATIC_REQUIRE(m.size() == 2);
+    STATIC_REQUIRE(m.get(3) == 3);
+    STATIC_REQUIRE(m.begin()->key == 1);
+}
+
+TEST_CASE("bounds and range queries", "[sorted_cx_map]") {
+    constexpr static auto m =
+        stdx::sorted_cx_map<int, int, 8>{V{10, 1}, V{20, 2}, V{30, 3}};
+    STATIC_REQUIRE(m.lower_bound(20)->key == 20);
+    STATIC_REQUIRE(m.upper_bound(20)->key == 30);
+    STATIC_REQUIRE(m.lower_bound(15)->key == 20);
+    STATIC_REQUIRE(m.lower_bound(5) == m.begin());
+    STATIC_REQUIRE(m.lower_bound(35) == m.end());
+    STATIC_REQUIRE(m.upper_bound(30) == m.end());
+    STATIC_REQUIRE(m.find(25) == m.end());
+    STATIC_REQUIRE(m.find(30)->value == 3);
+
+    constexpr auto r = m.equal_range(20);
+    STATIC_REQUIRE(std::distance(r.first, r.second) == 1);
+    constexpr auto e = m.equal_range(25);
+    STATIC_REQUIRE(e.first == e.second);
+    STATIC_REQUIRE(std::distance(m.lower_bound(15), m.upper_bound(30)) == 2);
+}
+
+TEST_CASE("batch insert_or_assign", "[sorted_cx_map]") {
+    constexpr auto m = [] {
+        auto t = stdx::sorted_cx_map<int, int, 8>{V{5, 0}, V{1, 0}};
+        auto const batch = std::array{V{4, 4}, V{5, 5}, V{2, 2}, V{4, 6}};
+        t.insert_or_assign(stdx::span{batch});
+        return t;
+    }();
+    STATIC_REQUIRE(keys_of(m) == std::array{1, 2, 4, 5, 0, 0, 0, 0});
+    STATIC_REQUIRE(m.size() == 4);
+    STATIC_REQUIRE(m.get(4) == 6);
+    STATIC_REQUIRE(m.get(5) == 5);
+    STATIC_REQUIRE(m.get(1) == 0);
+}
+
+TEST_CASE("custom comparison", "[sorted_cx_map]") {
+    constexpr auto m = [] {
+        auto t = stdx::sorted_cx_map<int, int, 4, std::greater<>>{};
+        t.put(1, 1);
+        t.put(3, 3);
+        t.put(2, 2);
+        return t;
+    }();
+    STATIC_REQUIRE(keys_of(m) == std::array{3, 2, 1, 0});
+    STATIC_REQUIRE(m.lower_bound(2)->key == 2);
+}
+
+TEST_CASE("lookups agree with std::lower_bound", "[sorted_cx_map]") {
+    auto m = stdx::sorted_cx_map<int, int, 100>{};
+    for (auto i = 0; i < 100; ++i) {
+        m.put(i * 3, i);
+    }
+    for (auto k = -2; k < 305; ++k) {
+        auto const expected = std::lower_bound(
+            m.begin(), m.end(), k,
+            [](auto const &v, int key) { return v.key < key; });
+        REQUIRE(m.lower_bound(k) == expected);
+        REQUIRE(m.contains(k) == (k >= 0 and k < 300 and k % 3 == 0));
+    }
+}
@@ -0,0 +1,136 @@
+#include <stdx/iterator.hpp>
+#include <stdx/sorted_cx_set.hpp>
+#include <stdx/span.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace {
+template <typename S> constexpr auto to_array(S const &s) {
+    std::array<int, S::capacity()> r{};
+    std::copy(s.begin(), s.end(), r.begin());
+    return r;
+}
+} // namespace
+
+TEST_CASE("empty and size", "[sorted_cx_set]") {
+    auto s = stdx::sorted_cx_set<int, 8>{};
+    CHECK(s.empty());
+    CHECK(s.insert(3));
+    CHECK(not s.insert(3));
+    CHECK(s.size() == 1);
+    STATIC_REQUIRE(stdx::ct_capacity_v<decltype(s)> == 8);
+}
+
+TEST_CASE("CTAD", "[sorted_cx_set]") {
+    constexpr auto s = stdx::sorted_cx_set{5, 3, 1, 3};
+    STATIC_REQUIRE(std::is_same_v<decltype(s),
+                                  stdx::sorted_cx_set<int, 4> const>);
+    STATIC_REQUIRE(s.size() == 3);
+    STATIC_REQUIRE(to_array(s) == std::array{1, 3, 5, 0});
+}
+
+TEST_CASE("insert keeps keys in order", "[sorted_cx_set]") {
+    constexpr auto s = [] {
+        auto t = stdx::sorted_cx_set<int, 4>{};
+        t.insert(4);
+        t.insert(2);
+        t.insert(3);
+        t.insert(1);
+        return t;
+    }();
+    STATIC_REQUIRE(to_array(s) == std::array{1, 2, 3, 4});
+    STATIC_REQUIRE(s.full());
+}
+
+TEST_CASE("contains and erase", "[sorted_cx_set]") {
+    auto s = stdx::sorted_cx_set<int, 8>{1, 2, 3};
+    CHECK(s.contains(2));
+    CHECK(s.erase(2) == 1u);
+    CHECK(s.erase(2) == 0u);
+    CHECK(not s.contains(2));
+    CHECK(s.contains(1));
+    CHECK(s.contains(3));
+    CHECK(s.pop_back() == 3);
+}
+
+TEST_CASE("bounds and range queries", "[sorted_cx_set]") {
+    constexpr static auto s = stdx::sorted_cx_set<int, 8>{10, 20, 30, 40};
+    STATIC_REQUIRE(*s.lower_bound(15) == 20);
+    STATIC_REQUIRE(*s.upper_bound(20) == 30);
+    STATIC_REQUIRE(s.lower_bound(45) == s.end());
+    STATIC_REQUIRE(std::distance(s.lower_bound(20), s.upper_bound(35)) == 2);
+    STATIC_REQUIRE(s.find(25) == s.end());
+    STATIC_REQUIRE(*s.find(30) == 30);
+    constexpr auto r = s.equal_range(40);
+    STATIC_REQUIRE(std::distance(r.first, r.second) == 1);
+}
+
+TEST_CASE("batch insert", "[sorted_cx_set]") {
+    constexpr auto s = [] {
+        auto t = stdx::sorted_cx_set<int, 8>{7, 1};
+        auto const batch = std::array{5, 1, 3, 5};
+        t.insert(stdx::span{batch});
+        return t;
+    }();
+    STATIC_REQUIRE(s.size() == 4);
+    STATIC_REQUIRE(to_array(s) == std::array{1, 3, 5, 7, 0, 0, 0, 0});
+}
+
+TEST_CASE("merge", "[sorted_cx_set]") {
+    constexpr auto s = [] {
+        auto t = stdx::sorted_cx_set<int, 8>{1, 3, 5};
+        t.merge(stdx::sorted_cx_set<int, 4>{2, 3, 6});
+        return t;
+    }();
+    STATIC_REQUIRE(s.size() == 5);
+    STATIC_REQUIRE(to_array(s) == std::array{1, 2, 3, 5, 6, 0, 0, 0});
+}
+
+TEST_CASE("union", "[sorted_cx_set]") {
+    constexpr auto a = stdx::sorted_cx_set<int, 4>{1, 3, 5, 7};
+    constexpr auto b = stdx::sorted_cx_set<int, 3>{2, 3, 8};
+    constexpr auto u = set_union(a, b);
+    STATIC_REQUIRE(
+        std::is_same_v<decltype(u), stdx::sorted_cx_set<int, 7> const>);
+    STATIC_REQUIRE(to_array(u) == std::array{1, 2, 3, 5, 7, 8, 0});
+}
+
+TEST_CASE("intersection", "[sorted_cx_set]") {
+    constexpr auto a = stdx::sorted_cx_set<int, 5>{1, 3, 5, 7, 9};
+    constexpr auto b = stdx::sorted_cx_set<int, 3>{3, 4, 9};
+    constexpr auto i = set_intersection(a, b);
+    STATIC_REQUIRE(
+        std::is_same_v<decltype(i), stdx::sorted_cx_set<int, 3> const>);
+    STATIC_REQUIRE(to_array(i) == std::array{3, 9, 0});
+    STATIC_REQUIRE(set_intersection(b, a) == i);
+}
+
+TEST_CASE("set operations agree with std algorithms", "[sorted_cx_set]") {
+    auto a = stdx::sorted_cx_set<int, 64>{};
+    auto b = stdx::sorted_cx_set<int, 64>{};
+    for (auto i = 0; i < 64; ++i) {
+        a.insert(i * 2);
+        b.insert(i * 3);
+    }
+    auto expected_union = std::array<int, 128>{};
+    auto const ue = std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                                   expected_union.begin());
+    auto const u = set_union(a, b);
+    REQUIRE(u.size() == static_cast<std::size_t>(
+                            std::distance(expected_union.begin(), ue)));
+    CHECK(std::equal(u.begin(), u.end(), expected_union.begin()));
+
+    auto expected_int = std::array<int, 64>{};
+    auto const ie = std::set_intersection(a.begin(), a.end(), b.begin(),
+                                          b.end(), expected_int.begin());
+    auto const i = set_intersection(a, b);
+    REQUIRE(i.size() == static_cast<std::size_t>(
+                            std::distance(expected_int.begin(), ie)));
+    CHECK(std::equal(i.begin(), i.end(), expected_int.begin()));
+}
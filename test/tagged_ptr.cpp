@@ -0,0 +1,123 @@
+#include <stdx/tagged_ptr.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace {
+struct node {
+    // atomic because a pop may read next from a node that another thread has
+    // popped and is pushing again: the tag makes that pop's CAS fail
+    std::atomic<node *> next{};
+    int value{};
+};
+} // namespace
+
+TEST_CASE("tagged_ptr next bumps the tag", "[tagged_ptr]") {
+    auto n = node{};
+    constexpr auto t = stdx::tagged_ptr<node>{nullptr, 41};
+    STATIC_REQUIRE(t.next(nullptr).tag == 42);
+    CHECK(t.next(&n) == stdx::tagged_ptr<node>{&n, 42});
+}
+
+TEST_CASE("atomic_tagged_ptr is double width", "[tagged_ptr]") {
+    STATIC_REQUIRE(sizeof(stdx::atomic_tagged_ptr<node>) ==
+                   2 * sizeof(void *));
+    STATIC_REQUIRE(alignof(stdx::atomic_tagged_ptr<node>) ==
+                   2 * sizeof(void *));
+}
+
+TEST_CASE("atomic_tagged_ptr load, store and exchange", "[tagged_ptr]") {
+    auto n = node{};
+    auto a = stdx::atomic_tagged_ptr<node>{};
+    CHECK(a.load() == stdx::tagged_ptr<node>{});
+    a.store({&n, 1});
+    CHECK(a.load() == stdx::tagged_ptr<node>{&n, 1});
+    CHECK(a.exchange({nullptr, 2}) == stdx::tagged_ptr<node>{&n, 1});
+    CHECK(a.load() == stdx::tagged_ptr<node>{nullptr, 2});
+}
+
+TEST_CASE("atomic_tagged_ptr compare_exchange", "[tagged_ptr]") {
+    auto n = node{};
+    auto a = stdx::atomic_tagged_ptr<node>{{&n, 5}};
+    auto expected = stdx::tagged_ptr<node>{&n, 4};
+    CHECK(not a.compare_exchange_strong(expected, {nullptr, 6}));
+    CHECK(expected == stdx::tagged_ptr<node>{&n, 5});
+    CHECK(a.compare_exchange_strong(expected, expected.next(nullptr)));
+    CHECK(a.load() == stdx::tagged_ptr<node>{nullptr, 6});
+}
+
+namespace {
+// a Treiber stack: the tag stops a pop from succeeding when the top node
+// has been popped and pushed back between its load and its CAS
+struct stack {
+    stdx::atomic_tagged_ptr<node> top{};
+
+    auto push(node *n) -> void {
+        auto t = top.load();
+        do {
+            n->next.store(t.ptr, std::memory_order_relaxed);
+        } while (not top.compare_exchange_weak(t, t.next(n)));
+    }
+
+    auto pop() -> node * {
+        auto t = top.load();
+        while (t.ptr != nullptr and
+               not top.compare_exchange_weak(
+                   t, t.next(t.ptr->next.load(std::memory_order_relaxed)))) {
+        }
+        return t.ptr;
+    }
+};
+} // namespace
+
+TEST_CASE("atomic_tagged_ptr stack under contention", "[tagged_ptr]") {
+    constexpr auto num_nodes = 64;
+    constexpr auto num_threads = 4;
+    constexpr auto rounds = 20'000;
+
+    auto nodes = std::array<node, num_nodes>{};
+    auto s = stack{};
+    for (auto i = 0; i < num_nodes; ++i) {
+        nodes[static_cast<std::size_t>(i)].value = i;
+        s.push(&nodes[static_cast<std::size_t>(i)]);
+    }
+
+    auto owners = std::array<std::atomic<int>, num_nodes>{};
+    auto errors = std::atomic<int>{};
+    auto work = [&] {
+        for (auto r = 0; r < rounds; ++r) {
+            auto *n = s.pop();
+            if (n == nullptr) {
+                continue;
+            }
+            auto &owner = owners[static_cast<std::size_t>(n->value)];
+            if (owner.fetch_add(1) != 0) {
+                ++errors;
+            }
+            owner.fetch_sub(1);
+            s.push(n);
+        }
+    };
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0; t < num_threads; ++t) {
+        threads.emplace_back(work);
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    CHECK(errors == 0);
+
+    auto seen = std::array<bool, num_nodes>{};
+    auto count = 0;
+    while (auto *n = s.pop()) {
+        CHECK(not seen[static_cast<std::size_t>(n->value)]);
+        seen[static_cast<std::size_t>(n->value)] = true;
+        ++count;
+    }
+    CHECK(count == num_nodes);
+}
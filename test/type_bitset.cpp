@@ -209,3 +209,73 @@ TEST_CASE("for_each (unset bits)", "[type_bitset]") {
     });
     CHECK(result == "int0float1bool2");
 }
+
+TEST_CASE("for_each (switch dispatch)", "[type_bitset]") {
+    constexpr auto bs = stdx::type_bitset<int, float, bool>{0b101ul};
+    auto result = std::string{};
+    bs.for_each<stdx::set_bit, stdx::switch_dispatch>(
+        [&]<typename T, std::size_t I>() -> void {
+            result +=
+                std::string{stdx::type_as_string<T>()} + std::to_string(I);
+        });
+    CHECK(result == "int0bool2");
+}
+
+TEST_CASE("for_each (switch dispatch, unset bits)", "[type_bitset]") {
+    constexpr auto bs = stdx::type_bitset<int, float, bool>{0b101ul};
+    auto result = std::string{};
+    bs.for_each<stdx::unset_bit, stdx::switch_dispatch>(
+        [&]<typename T, std::size_t I>() -> void {
+            result +=
+                std::string{stdx::type_as_string<T>()} + std::to_string(I);
+        });
+    CHECK(result == "float1");
+}
+
+namespace {
+template <std::size_t> struct tag {};
+
+template <std::size_t... Is>
+auto many_types(std::index_sequence<Is...>) -> stdx::type_bitset<tag<Is>...>;
+
+template <std::size_t N>
+using many_t = decltype(many_types(std::make_index_sequence<N>{}));
+
+template <std::size_t N>
+using num_types = std::integral_constant<std::size_t, N>;
+
+struct sum_indices {
+    std::size_t sum{};
+    std::size_t calls{};
+    template <typename T, std::size_t I> constexpr auto operator()() -> void {
+        static_assert(std::is_same_v<T, tag<I>>);
+        sum += I;
+        ++calls;
+    }
+};
+} // namespace
+
+TEMPLATE_TEST_CASE("for_each dispatch agrees for many types", "[type_bitset]",
+                   num_types<8>, num_types<64>, num_types<300>) {
+    using bs_t = many_t<TestType::value>;
+    auto bs = bs_t{stdx::all_bits};
+    auto const t = bs.template for_each<stdx::set_bit, stdx::table_dispatch>(
+        sum_indices{});
+    auto const s = bs.template for_each<stdx::set_bit, stdx::switch_dispatch>(
+        sum_indices{});
+    CHECK(s.calls == TestType::value);
+    CHECK(s.sum == TestType::value * (TestType::value - 1) / 2);
+    CHECK(s.sum == t.sum);
+    CHECK(s.calls == t.calls);
+}
+
+TEST_CASE("for_each switch dispatch at compile time", "[type_bitset]") {
+    constexpr auto s = [] {
+        auto bs = many_t<40>{};
+        bs.set<tag<3>, tag<17>, tag<39>>();
+        return bs.for_each<stdx::set_bit, stdx::switch_dispatch>(
+            sum_indices{});
+    }();
+    STATIC_REQUIRE(s.calls == 3);
+    STATIC_REQUIRE(s.sum == 3 + 17 + 39);
+}